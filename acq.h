@@ -0,0 +1,49 @@
+/**
+ * Interface de aquisição da tensão do diodo
+ *
+ * Cada backend entrega a tensão no diodo (V) e o código bruto do conversor,
+ * ou, nas sondas digitais, a temperatura já convertida. O backend é
+ * escolhido na compilação (-DACQ_BACKEND=sar|sdm|ads1115|ds18b20|sim) e o
+ * resto do processamento (tipo de sensor, filtro, telas) não depende dele.
+ */
+
+#ifndef ACQ_H
+#define ACQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Configurações do ADC interno
+#define ADC_PIN     26      // GPIO 26 (Canal ADC0)
+#define ADC_NUM     0       // Número do canal ADC
+#define ADC_VREF    3.3f  // Tensão de referência medida
+#define ADC_RANGE   (1 << 12) // Faixa do ADC (12 bits = 4096 valores)
+
+typedef struct {
+    float voltage;      // Tensão no diodo (V)
+    uint32_t code;      // Código bruto (escala de 2^bits)
+    float celsius;      // Temperatura (backends com celsius = true)
+} acq_sample_t;
+
+typedef struct {
+    const char *name;
+    uint8_t bits;               // Resolução do código
+    uint32_t adc_channels;      // Canais do ADC interno usados (round-robin)
+    bool celsius;               // Entrega a temperatura (sem a lei do diodo)
+    bool ratiometric;           // Código relativo ao 3V3 (razão direta do divisor do NTC)
+    void (*init)(void);
+    // Não bloqueia: false quando ainda não há leitura nova
+    bool (*read)(acq_sample_t *sample);
+    // Trabalho adiado para o loop principal (ex.: I2C), NULL se não houver
+    void (*poll)(void);
+    // Falha que o próprio backend detecta (ex.: nenhuma sonda), NULL se não houver
+    bool (*fault)(void);
+} acq_backend_t;
+
+extern const acq_backend_t acq_sar;     // ADC SAR interno de 12 bits
+extern const acq_backend_t acq_sdm;     // Sigma-delta no PIO (sdm_adc.pio)
+extern const acq_backend_t acq_ads1115; // ADC externo de 16 bits (I2C)
+extern const acq_backend_t acq_ds18b20; // Sondas DS18B20 (1-Wire no PIO)
+extern const acq_backend_t acq_sim;     // Leira simulada (plant.c)
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * Backend de aquisição pelo ADS1115 (ADC delta-sigma de 16 bits, I2C)
+ *
+ * O conversor fica em conversão contínua com PGA de ±1,024 V no AIN0 (diodo)
+ * e o pino ALERT/RDY pulsa ao fim de cada conversão. A interrupção do RDY só
+ * sinaliza; o loop principal (poll) coloca a leitura na fila do barramento
+ * com prioridade alta, à frente das páginas do display ainda pendentes. As
+ * conversões se acumulam até a próxima leitura do timer, que recebe a média.
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "i2c_bus.h"
+#include "acq.h"
+#include "log.h"
+
+#define ADS_I2C_ADDR    0x48        // ADDR ligado ao GND
+#define ADS_RDY_PIN     16          // ALERT/RDY (dreno aberto)
+#define ADS_FSR         1.024f      // Fundo de escala do PGA (V)
+
+// Registradores
+#define ADS_REG_CONV    0x00
+#define ADS_REG_CONFIG  0x01
+#define ADS_REG_LO      0x02
+#define ADS_REG_HI      0x03
+
+// Configuração: AIN0 x GND, PGA ±1,024 V, contínuo, 128 SPS, RDY a cada conversão
+#define ADS_CONFIG      0x4680
+
+static volatile bool ready = false; // RDY sinalizou conversão nova
+static i2c_txn_t read_txn;          // Leitura da conversão (assíncrona)
+static uint8_t read_buf[2];
+static int32_t acc_sum = 0;         // Conversões acumuladas desde a última leitura
+static uint32_t acc_n = 0;
+
+static bool ads_write(const uint8_t *buf, uint16_t len) {
+    i2c_txn_t txn = {
+        .addr = ADS_I2C_ADDR,
+        .prio = I2C_PRIO_HIGH,
+        .dev = I2C_DEV_SENSOR,
+        .prefix = -1,
+        .tx = buf,
+        .tx_len = len,
+    };
+    return i2c_bus_transfer_blocking(&txn);
+}
+
+static bool ads_write_reg(uint8_t reg, uint16_t value) {
+    uint8_t buf[3] = { reg, value >> 8, value & 0xFF };
+    return ads_write(buf, 3);
+}
+
+// Interrupção do I2C: acumula a conversão lida
+static void ads_read_done(i2c_txn_t *txn, bool ok) {
+    if (!ok) return;
+    int16_t value = (int16_t)(read_buf[0] << 8 | read_buf[1]);
+    uint32_t irq = save_and_disable_interrupts();
+    acc_sum += value;
+    acc_n++;
+    restore_interrupts(irq);
+}
+
+static void ads_rdy_isr(void) {
+    if (gpio_get_irq_event_mask(ADS_RDY_PIN) & GPIO_IRQ_EDGE_FALL) {
+        gpio_acknowledge_irq(ADS_RDY_PIN, GPIO_IRQ_EDGE_FALL);
+        ready = true;
+    }
+}
+
+static void ads_init(void) {
+    // Limiares com o bit mais significativo 0 e 1 colocam o ALERT no modo RDY
+    bool ok = ads_write_reg(ADS_REG_LO, 0x0000) &&
+              ads_write_reg(ADS_REG_HI, 0x8000) &&
+              ads_write_reg(ADS_REG_CONFIG, ADS_CONFIG);
+    if (!ok) LOG("ADS1115 nao encontrado");
+
+    // Ponteiro fica no registrador de conversão: cada leitura é um só acesso
+    uint8_t reg = ADS_REG_CONV;
+    ads_write(&reg, 1);
+    read_txn = (i2c_txn_t){
+        .addr = ADS_I2C_ADDR,
+        .prio = I2C_PRIO_HIGH,
+        .dev = I2C_DEV_SENSOR,
+        .prefix = -1,
+        .rx = read_buf,
+        .rx_len = 2,
+        .done = ads_read_done,
+    };
+
+    gpio_init(ADS_RDY_PIN);
+    gpio_set_dir(ADS_RDY_PIN, GPIO_IN);
+    gpio_pull_up(ADS_RDY_PIN);
+    // O callback de GPIO é do botão: o RDY usa um handler próprio
+    gpio_add_raw_irq_handler(ADS_RDY_PIN, ads_rdy_isr);
+    gpio_set_irq_enabled(ADS_RDY_PIN, GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+// Loop principal: enfileira a leitura da conversão sinalizada pelo RDY
+static void ads_poll(void) {
+    if (!ready || read_txn.busy) return;
+    ready = false;
+    i2c_bus_submit(&read_txn);
+}
+
+// Timer: média das conversões acumuladas (não acessa o I2C)
+static bool ads_read(acq_sample_t *sample) {
+    if (acc_n == 0) return false;
+    int32_t mean = acc_sum / (int32_t)acc_n;
+    sample->voltage = (float)acc_sum / acc_n * ADS_FSR / 32768.0f;
+    sample->code = mean < 0 ? 0 : mean;
+    acc_sum = 0;
+    acc_n = 0;
+    return true;
+}
+
+const acq_backend_t acq_ads1115 = {
+    .name = "ADS1115",
+    .bits = 15,             // Entrada simples: só a metade positiva da escala
+    .adc_channels = 0,
+    .init = ads_init,
+    .read = ads_read,
+    .poll = ads_poll,
+};
@@ -0,0 +1,184 @@
+/**
+ * Backend de aquisição por sondas DS18B20 (1-Wire no PIO)
+ *
+ * Na inicialização a busca de ROM encontra até DS_MAX_PROBES sondas no
+ * barramento. Depois um ciclo sem bloqueio roda pelo loop principal (poll):
+ * conversão em todas as sondas (SKIP ROM + 0x44), espera de 750 ms sem
+ * ocupar a CPU e leitura do scratchpad de cada sonda (MATCH ROM + 0xBE),
+ * cada etapa uma transação de slots enviada por DMA. A temperatura entregue
+ * ao filtro é a média das sondas com leitura válida: presença, CRC certo e
+ * nem o scratchpad todo em zero (DQ em curto com o GND passa no CRC) nem o
+ * valor de power-on 85,0 °C (sonda que perdeu a alimentação parasita no
+ * meio da conversão). Sem nenhuma sonda na busca, ou com DS_FAULT_CYCLES
+ * ciclos seguidos sem leitura válida, o backend informa falha (fault) e o
+ * diagnóstico tira a medida de uso.
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "onewire.h"
+#include "acq.h"
+#include "log.h"
+
+#define DS_PIN          22          // Dados das sondas (pull-up de 4,7k)
+#define DS_MAX_PROBES   4
+#define DS_CONVERT_MS   750         // Conversão de 12 bits
+#define DS_CONVERT      0x44
+#define DS_READ_SCRATCH 0xBE
+#define DS_FAMILY       0x28
+#define DS_POWER_ON_RAW 0x0550      // 85,0 °C: scratchpad sem conversão
+#define DS_FAULT_CYCLES 3           // Ciclos seguidos sem leitura para a falha
+
+// Maior transação: reset + MATCH ROM + ROM + comando + 9 bytes
+#define DS_SLOTS        (1 + 8 + 64 + 8 + 72)
+
+typedef enum { DS_IDLE, DS_CONVERTING, DS_WAITING, DS_READING } ds_state_t;
+
+static uint64_t roms[DS_MAX_PROBES];
+static int probes = 0;
+static ds_state_t state = DS_IDLE;
+static int probe = 0;               // Sonda sendo lida
+static uint32_t convert_ms = 0;
+static uint16_t data_slot = 0;
+
+static uint32_t tx[DS_SLOTS], rx[DS_SLOTS];
+static ow_txn_t txn;
+
+// Resultado do último ciclo completo
+static float cycle_sum = 0.0f;
+static int cycle_n = 0;
+static int16_t cycle_raw = 0;
+static volatile bool fresh = false;
+static float result = 0.0f;
+static int16_t result_raw = 0;
+static uint32_t empty_cycles = 0;   // Ciclos seguidos sem nenhuma sonda válida
+
+// Falhas por sonda: leituras rejeitadas no total e ciclos seguidos sem leitura
+static uint32_t probe_errors[DS_MAX_PROBES];
+static uint32_t probe_failed_cycles[DS_MAX_PROBES];
+
+static void ds_init(void) {
+    ow_init(DS_PIN);
+    probes = ow_search(roms, DS_MAX_PROBES);
+
+    // Mantém só as DS18B20 (família 0x28), na ordem da busca
+    int n = 0;
+    for (int i = 0; i < probes; i++) {
+        if ((roms[i] & 0xFF) == DS_FAMILY) roms[n++] = roms[i];
+    }
+    probes = n;
+    LOG("DS18B20: %d sonda(s)", probes);
+}
+
+// Só acorda o loop principal (__wfi) ao fim da conversão
+static int64_t convert_done(alarm_id_t id, void *user_data) {
+    return 0;
+}
+
+static void start_convert(void) {
+    ow_begin(&txn, tx, rx, DS_SLOTS);
+    ow_add_reset(&txn);
+    ow_add_byte(&txn, OW_SKIP_ROM);
+    ow_add_byte(&txn, DS_CONVERT);
+    ow_start(&txn);
+    state = DS_CONVERTING;
+}
+
+static void start_read(int i) {
+    ow_begin(&txn, tx, rx, DS_SLOTS);
+    ow_add_reset(&txn);
+    ow_add_byte(&txn, OW_MATCH_ROM);
+    for (int b = 0; b < 8; b++) ow_add_byte(&txn, roms[i] >> (8 * b));
+    ow_add_byte(&txn, DS_READ_SCRATCH);
+    data_slot = ow_add_read(&txn, 9);
+    ow_start(&txn);
+    state = DS_READING;
+}
+
+static void finish_read(int i) {
+    uint8_t scratch[9], any = 0;
+    for (int b = 0; b < 9; b++) {
+        scratch[b] = ow_get_byte(&txn, data_slot + 8 * b);
+        any |= scratch[b];
+    }
+    int16_t raw = (int16_t)(scratch[1] << 8 | scratch[0]);
+    if (ow_presence(&txn, 0) && ow_crc8(scratch, 9) == 0 && any && raw != DS_POWER_ON_RAW) {
+        if (cycle_n == 0) cycle_raw = raw;
+        cycle_sum += raw / 16.0f;   // 1/16 °C por unidade (12 bits)
+        cycle_n++;
+        if (probe_failed_cycles[i] >= DS_FAULT_CYCLES) LOG("DS18B20: sonda %d voltou", i);
+        probe_failed_cycles[i] = 0;
+        return;
+    }
+    probe_errors[i]++;
+    if (++probe_failed_cycles[i] == DS_FAULT_CYCLES) {
+        LOG("DS18B20: sonda %d sem leitura (%u erros)", i, probe_errors[i]);
+    }
+}
+
+// Loop principal: avança o ciclo conversão -> espera -> leitura das sondas
+static void ds_poll(void) {
+    if (probes == 0 || ow_busy()) return;
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+
+    switch (state) {
+        case DS_IDLE:
+            start_convert();
+            break;
+        case DS_CONVERTING:
+            convert_ms = now;
+            add_alarm_in_ms(DS_CONVERT_MS, convert_done, NULL, true);
+            state = DS_WAITING;
+            break;
+        case DS_WAITING:
+            if (now - convert_ms < DS_CONVERT_MS) break;
+            probe = 0;
+            cycle_sum = 0.0f;
+            cycle_n = 0;
+            start_read(probe);
+            break;
+        case DS_READING:
+            finish_read(probe);
+            if (++probe < probes) {
+                start_read(probe);
+                break;
+            }
+            if (cycle_n) {
+                uint32_t irq = save_and_disable_interrupts();
+                result = cycle_sum / cycle_n;
+                result_raw = cycle_raw;
+                fresh = true;
+                restore_interrupts(irq);
+                empty_cycles = 0;
+            } else {
+                empty_cycles++;
+            }
+            start_convert();
+            break;
+    }
+}
+
+static bool ds_read(acq_sample_t *sample) {
+    if (!fresh) return false;
+    fresh = false;
+    sample->celsius = result;
+    sample->voltage = 0.0f;
+    sample->code = (uint16_t)result_raw;
+    return true;
+}
+
+// Nenhuma sonda na busca ou nenhuma leitura válida nos últimos ciclos
+static bool ds_fault(void) {
+    return probes == 0 || empty_cycles >= DS_FAULT_CYCLES;
+}
+
+const acq_backend_t acq_ds18b20 = {
+    .name = "DS18B20",
+    .bits = 12,
+    .adc_channels = 0,
+    .celsius = true,
+    .init = ds_init,
+    .read = ds_read,
+    .poll = ds_poll,
+    .fault = ds_fault,
+};
@@ -0,0 +1,30 @@
+/**
+ * Backend de aquisição pelo ADC SAR interno (ADC0)
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "acq.h"
+
+static void sar_init(void) {
+    adc_gpio_init(ADC_PIN); // Configura GPIO26 como entrada analógica
+    adc_select_input(ADC_NUM); // Seleciona o canal ADC0
+}
+
+// Começa a rodada do round-robin no diodo; o canal seguinte fica para o VSYS
+static bool sar_read(acq_sample_t *sample) {
+    adc_select_input(ADC_NUM);
+    uint16_t raw = adc_read(); // Lê valor bruto (0-4095)
+    sample->code = raw;
+    sample->voltage = (raw * ADC_VREF) / ADC_RANGE; // Converte para tensão
+    return true;
+}
+
+const acq_backend_t acq_sar = {
+    .name = "SAR",
+    .bits = 12,
+    .adc_channels = 1u << ADC_NUM,
+    .ratiometric = true,
+    .init = sar_init,
+    .read = sar_read,
+};
@@ -0,0 +1,87 @@
+/**
+ * Backend de aquisição sigma-delta no PIO
+ *
+ * Montagem (Rin = Rfb = 100k, C = 100n, comparador com limiar VREF/2):
+ *   diodo --Rin--+--Rfb-- GP14 (realimentação)
+ *                |
+ *                C --- GND
+ *                |
+ *           comparador -> GP15
+ *
+ * O PIO modula e conta os bits em 1 de cada janela de 65536 bits; o DMA
+ * copia as contagens para um buffer circular sem intervenção da CPU. Cada
+ * leitura soma as janelas concluídas desde a anterior (decimação), então a
+ * resolução cresce com o período de amostragem.
+ *
+ * Modelo do modulador para testes no computador: tools/sdm_model.py
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "acq.h"
+#include "sdm_adc.pio.h"
+
+#define SDM_PIO         pio0        // Bloco PIO do modulador
+#define SDM_FB_PIN      14          // Realimentação (side-set)
+#define SDM_CMP_PIN     15          // Saída do comparador
+#define SDM_BIT_HZ      1000000     // Taxa do modulador (bits/s)
+#define SDM_WINDOW      65536       // Bits por janela (contagem de 16 bits)
+#define SDM_RING_WORDS  16          // Janelas guardadas (potência de 2)
+#define SDM_RING_BITS   6           // log2 do buffer circular em bytes
+#define SDM_VTH         (ADC_VREF / 2) // Limiar do comparador
+#define SDM_R_RATIO     1.0f        // Rin / Rfb
+
+static int sm = -1;
+static int dma_chan = -1;
+static uint32_t ring[SDM_RING_WORDS] __aligned(SDM_RING_WORDS * 4);
+static uint32_t consumed = 0;       // Janelas já usadas em leituras
+
+static void sdm_init(void) {
+    uint offset = pio_add_program(SDM_PIO, &sdm_adc_program);
+    sm = pio_claim_unused_sm(SDM_PIO, true);
+    float clkdiv = (float)clock_get_hz(clk_sys) / (SDM_BIT_HZ * 3); // 3 ciclos por bit
+    sdm_adc_program_init(SDM_PIO, sm, offset, SDM_FB_PIN, SDM_CMP_PIN, SDM_WINDOW, clkdiv);
+
+    // DMA da FIFO para o buffer circular. Com a contagem máxima de
+    // transferências (~15 janelas/s) o canal roda por anos sem reinício
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, SDM_RING_BITS);
+    channel_config_set_dreq(&c, pio_get_dreq(SDM_PIO, sm, false));
+    dma_channel_configure(dma_chan, &c, ring, &SDM_PIO->rxf[sm], 0xFFFFFFFF, true);
+
+    pio_sm_set_enabled(SDM_PIO, sm, true);
+}
+
+static bool sdm_read(acq_sample_t *sample) {
+    // Janelas concluídas: a contagem de transferências parte de 0xFFFFFFFF
+    uint32_t done = ~dma_channel_hw_addr(dma_chan)->transfer_count;
+    uint32_t n = done - consumed;
+    if (n == 0) return false;
+
+    // Leitura atrasada: usa só as mais recentes (a mais antiga pode estar
+    // sendo sobrescrita)
+    if (n > SDM_RING_WORDS - 1) n = SDM_RING_WORDS - 1;
+    uint32_t sum = 0;
+    for (uint32_t i = 1; i <= n; i++) sum += ring[(done - i) % SDM_RING_WORDS];
+    consumed = done;
+
+    // Equilíbrio no nó: Vin = Vth - (Rin/Rfb) * (d * VREF - Vth)
+    float d = (float)sum / ((float)n * SDM_WINDOW);
+    sample->code = sum / n;
+    sample->voltage = SDM_VTH - SDM_R_RATIO * (d * ADC_VREF - SDM_VTH);
+    return true;
+}
+
+const acq_backend_t acq_sdm = {
+    .name = "SDM",
+    .bits = 16,
+    .adc_channels = 0,
+    .init = sdm_init,
+    .read = sdm_read,
+};
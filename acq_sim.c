@@ -0,0 +1,56 @@
+/**
+ * Backend de aquisição simulado: a leira de plant.c no lugar do diodo
+ */
+
+#include "pico/stdlib.h"
+#include "acq.h"
+#include "plant.h"
+#include "control.h"
+#include "log.h"
+
+plant_params_t acq_sim_params = PLANT_DEFAULTS;
+float acq_sim_noise_lsb = 1.5f;
+uint32_t acq_sim_seed = 1;
+plant_t acq_sim_plant;
+
+static uint64_t last_us;
+static uint32_t rng;
+
+// Ruído aproximadamente gaussiano (soma de 4 uniformes, desvio 1)
+static float noise(void) {
+    float sum = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        rng ^= rng << 13;           // xorshift32
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        sum += (float)rng * (1.0f / 4294967296.0f);
+    }
+    return (sum - 2.0f) * 1.7320508f;
+}
+
+static void sim_init(void) {
+    plant_init(&acq_sim_plant, &acq_sim_params);
+    rng = acq_sim_seed ? acq_sim_seed : 1;
+    last_us = time_us_64();
+    LOG("Leira simulada: ambiente=%.1f aquecimento=%.2f C/h", acq_sim_params.ambient, acq_sim_params.heat_max);
+}
+
+// A leira avança até o instante da leitura com a saída atual do controle
+// no soprador; a tensão da sonda passa pelo conversor de 12 bits do SAR
+static bool sim_read(acq_sample_t *sample) {
+    uint64_t now = time_us_64();
+    plant_step(&acq_sim_plant, (now - last_us) * 1e-6f, control_stats.output / (float)CONTROL_OUT_MAX);
+    last_us = now;
+
+    float code = plant_diode_voltage(&acq_sim_plant) * (ADC_RANGE / ADC_VREF) + noise() * acq_sim_noise_lsb;
+    sample->code = code < 0.0f ? 0 : code > ADC_RANGE - 1 ? ADC_RANGE - 1 : (uint32_t)(code + 0.5f);
+    sample->voltage = (sample->code * ADC_VREF) / ADC_RANGE;
+    return true;
+}
+
+const acq_backend_t acq_sim = {
+    .name = "SIM",
+    .bits = 12,
+    .init = sim_init,
+    .read = sim_read,
+};
@@ -0,0 +1,32 @@
+/**
+ * Alarmes ativos (um bit por condição)
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "alarms.h"
+#include "screens.h"
+
+volatile uint32_t active_alarms = 0;
+
+// Pode ser chamada das interrupções: avisa as telas só quando algo muda
+void alarm_set(uint32_t alarm, bool on) {
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t old = active_alarms;
+    active_alarms = on ? (old | alarm) : (old & ~alarm);
+    restore_interrupts(irq);
+
+    if (active_alarms != old) screens_notify(DATA_ALARM);
+}
+
+// Texto curto (até 16 caracteres) exibido na tela de alarmes
+const char *alarm_name(uint32_t alarm) {
+    switch (alarm) {
+        case ALARM_TEMP_LOW: return "TEMP ABAIXO 40C";
+        case ALARM_BATTERY_LOW: return "BATERIA FRACA";
+        case ALARM_OVERHEAT: return "LEIRA ACIMA 70C";
+        case ALARM_SANITATION: return "SANITIZ. INCOMPL";
+        case ALARM_SENSOR: return "FALHA NO SENSOR";
+        default:             return "DESCONHECIDO";
+    }
+}
@@ -0,0 +1,22 @@
+/**
+ * Alarmes ativos (um bit por condição)
+ */
+
+#ifndef ALARMS_H
+#define ALARMS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ALARM_TEMP_LOW  (1u << 0)   // Temperatura abaixo de 40°C (LED aceso)
+#define ALARM_BATTERY_LOW (1u << 1) // Bateria fraca (modo de economia)
+#define ALARM_OVERHEAT  (1u << 2)   // Leira acima de 70°C (revirar)
+#define ALARM_SANITATION (1u << 3)  // Esfriou antes de 72 h acima de 55°C
+#define ALARM_SENSOR    (1u << 4)   // Sensor aberto, em curto, travado, ruidoso ou sem leitura
+
+extern volatile uint32_t active_alarms;
+
+void alarm_set(uint32_t alarm, bool on);
+const char *alarm_name(uint32_t alarm);
+
+#endif
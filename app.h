@@ -0,0 +1,20 @@
+/**
+ * Estado da medição compartilhado entre o main.c e os módulos de interface
+ */
+
+#ifndef APP_H
+#define APP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern bool show_fahrenheit;        // Unidade de exibição (false=Celsius)
+extern float raw_temp;              // Temperatura bruta (Celsius)
+extern float filtered_temp;         // Temperatura filtrada (Celsius)
+extern float voltage;               // Tensão lida do ADC
+extern uint32_t adc_raw;            // Último código bruto do conversor
+extern uint32_t sample_count;       // Amostras lidas desde o boot
+
+float celsius_to_fahrenheit(float celsius);
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * Benchmarks executados no boot quando o projeto é configurado com
+ * -DBENCHMARK=ON. Os resultados saem pela serial (stdio).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+#include "blit.h"
+#include "sensor.h"
+#include "lerp.h"
+#include "ntc_lut.h"
+#include "log.h"
+#include "crc.h"
+#include "hardware/clocks.h"
+#include "bench.h"
+
+#if BENCHMARK
+
+#include "raspberry26x32.h"
+
+#define BENCH_ITERATIONS 2000
+
+// raspberry26x32 comprimido com tools/rle_encode.py
+static const uint8_t raspberry26x32_rle[] = {
+    0x81, 0x00, 0x02, 0x0e, 0x7e, 0xfe, 0x84, 0xff, 0x81, 0xfe, 0x04, 0xfc, 0xf8, 0xfc, 0xfe, 0xfe,
+    0x84, 0xff, 0x02, 0xfe, 0x7e, 0x1e, 0x82, 0x00, 0x03, 0x80, 0xe0, 0xf8, 0xfd, 0x8e, 0xff, 0x07,
+    0xfd, 0xf8, 0xe0, 0x80, 0x00, 0x00, 0x1e, 0x7f, 0x94, 0xff, 0x01, 0x7f, 0x1e, 0x82, 0x00, 0x07,
+    0x03, 0x07, 0x0f, 0x1f, 0x1f, 0x3f, 0x3f, 0x7f, 0x83, 0xff, 0x81, 0x7f, 0x81, 0x3f, 0x81, 0x1f,
+    0x04, 0x0f, 0x07, 0x03, 0x00, 0x00,
+};
+
+static uint8_t bench_buf[SSD1306_BUF_LEN];
+
+// Mede o tempo médio de um blit e a vazão em pixels do bitmap por segundo
+static void bench_blit(const char *name, const bitmap_t *bmp, int16_t x, int16_t y, blit_mode_t mode) {
+    uint32_t pixels = bmp->width * bmp->height;
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) blit(bench_buf, x, y, bmp, mode);
+    uint32_t dt = (uint32_t)(time_us_64() - t0);
+    printf("%-20s %8.2f us/blit %7.2f Mpixel/s\n", name,
+           (float)dt / BENCH_ITERATIONS, (float)pixels * BENCH_ITERATIONS / dt);
+}
+
+// Mede o custo por amostra da conversão de um tipo de sensor
+static void bench_sensor(const sensor_type_t *type) {
+    acq_sample_t sample = { .voltage = 0.5f, .code = 620 };
+    volatile float sink;
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        sample.code = 620 + (i & 0x3FF);    // Varre trechos diferentes da tabela
+        sink = type->to_celsius(&sample, &acq_sar);
+    }
+    uint32_t dt = (uint32_t)(time_us_64() - t0);
+    (void)sink;
+    printf("%-20s %8.3f us/amostra\n", type->name, (float)dt / BENCH_ITERATIONS);
+}
+
+// Ciclos por amostra da busca na tabela do NTC e da mistura do filtro,
+// pelo interpolador e em software
+static void bench_lerp(const char *name, bool hw) {
+    volatile int32_t sink = 0;
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t code = (uint32_t)i * 32;     // Varre a tabela inteira
+        int32_t t = hw ? lerp_lut16(ntc_lut, code) : lerp_lut16_sw(ntc_lut, code);
+        sink = hw ? lerp_blend(sink, t, 16) : lerp_blend_sw(sink, t, 16);
+    }
+    uint32_t dt = (uint32_t)(time_us_64() - t0);
+    float cycles = (float)dt * (clock_get_hz(clk_sys) / 1e6f) / BENCH_ITERATIONS;
+    printf("%-20s %8.1f ciclos/amostra\n", name, cycles);
+}
+
+// Ciclos por chamada do LOG() com os argumentos de uma amostra. Só
+// BENCH_LOG_RECORDS registros, para caber no buffer sem descartes (saem
+// depois, no primeiro log_flush() do loop principal)
+#define BENCH_LOG_RECORDS 64
+static void bench_log(void) {
+    uint64_t t0 = time_us_64();
+    for (uint32_t i = 0; i < BENCH_LOG_RECORDS; i++) {
+        LOG("BENCH i=%u t=%.3f", i, 25.0f);
+    }
+    uint32_t dt = (uint32_t)(time_us_64() - t0);
+    float cycles = (float)dt * (clock_get_hz(clk_sys) / 1e6f) / BENCH_LOG_RECORDS;
+    printf("%-20s %8.1f ciclos/registro\n", "LOG (2 argumentos)", cycles);
+}
+
+// Vazão do CRC pelo sniffer do DMA (copiando) e em software
+#define BENCH_CRC_LEN 4096
+static uint8_t crc_src[BENCH_CRC_LEN], crc_dst[BENCH_CRC_LEN];
+
+static void bench_crc_rate(const char *name, int kind) {
+    volatile uint32_t sink = 0;
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < 16; i++) {
+        switch (kind) {
+            case 0: sink = crc32_copy(crc_dst, crc_src, BENCH_CRC_LEN); break;
+            case 1: sink = crc32_sw(crc_src, BENCH_CRC_LEN); break;
+            case 2: sink = crc16_copy(crc_dst, crc_src, BENCH_CRC_LEN, CRC16_INIT); break;
+            default: sink = crc16_sw(crc_src, BENCH_CRC_LEN, CRC16_INIT); break;
+        }
+    }
+    uint32_t dt = (uint32_t)(time_us_64() - t0);
+    (void)sink;
+    printf("%-20s %8.2f MB/s\n", name, 16.0f * BENCH_CRC_LEN / dt);
+}
+
+// Confere o sniffer contra a referência em software: valores de teste
+// conhecidos ("123456789") e trechos de tamanho e alinhamento variados,
+// com o CRC-16 continuado em dois pedaços
+static void bench_crc_check(void) {
+    static const char check[] = "123456789";
+    int errors = 0;
+    if (crc32_copy(NULL, check, 9) != 0xCBF43926u || crc32_sw(check, 9) != 0xCBF43926u) errors++;
+    if (crc16_copy(NULL, check, 9, CRC16_INIT) != 0x29B1 || crc16_sw(check, 9, CRC16_INIT) != 0x29B1) errors++;
+
+    uint32_t x = 12345;
+    for (int i = 0; i < BENCH_CRC_LEN; i++) crc_src[i] = (x = x * 1103515245u + 12345u) >> 24;
+    for (int i = 0; i < 200; i++) {
+        uint32_t off = (x = x * 1103515245u + 12345u) >> 21 & 0x3FF;
+        uint32_t len = (x = x * 1103515245u + 12345u) >> 20 & 0x7FF;
+        uint32_t cut = len / 3;
+        const uint8_t *p = crc_src + off;
+        if (crc32_copy(crc_dst, p, len) != crc32_sw(p, len)) errors++;
+        if (memcmp(crc_dst, p, len) != 0) errors++;
+        uint16_t c = crc16_copy(NULL, p, cut, CRC16_INIT);
+        if (crc16_copy(NULL, p + cut, len - cut, c) != crc16_sw(p, len, CRC16_INIT)) errors++;
+    }
+    printf("%-20s %8d erros\n", "conferencia", errors);
+}
+
+#endif
+
+void bench_run(void) {
+#if BENCHMARK
+    static uint8_t frame[SSD1306_BUF_LEN];
+    bitmap_t raw  = { raspberry26x32, IMG_WIDTH, IMG_HEIGHT, false };
+    bitmap_t rle  = { raspberry26x32_rle, IMG_WIDTH, IMG_HEIGHT, true };
+    bitmap_t full = { frame, SSD1306_WIDTH, SSD1306_HEIGHT, false };
+
+    sleep_ms(2000); // Tempo para abrir o terminal serial
+
+    printf("\n== blit (%d iteracoes) ==\n", BENCH_ITERATIONS);
+    bench_blit("copy alinhado", &raw, 10, 0, BLIT_COPY);
+    bench_blit("copy desalinhado", &raw, 10, 3, BLIT_COPY);
+    bench_blit("or", &raw, 10, 3, BLIT_OR);
+    bench_blit("and", &raw, 10, 3, BLIT_AND);
+    bench_blit("xor", &raw, 10, 3, BLIT_XOR);
+    bench_blit("rle or", &rle, 10, 3, BLIT_OR);
+    bench_blit("recortado", &raw, 115, -5, BLIT_OR);
+    bench_blit("tela cheia (dma)", &full, 0, 0, BLIT_COPY);
+
+    printf("\n== conversao para temperatura (%d iteracoes) ==\n", BENCH_ITERATIONS);
+    bench_sensor(&sensor_diode);
+    bench_sensor(&sensor_ntc);
+
+    printf("\n== tabela + filtro (%d iteracoes) ==\n", BENCH_ITERATIONS);
+    bench_lerp("interpolador", true);
+    bench_lerp("software", false);
+
+    printf("\n== log binario (%d registros) ==\n", BENCH_LOG_RECORDS);
+    bench_log();
+
+    printf("\n== crc (%d bytes) ==\n", BENCH_CRC_LEN);
+    bench_crc_check();
+    bench_crc_rate("crc32 dma", 0);
+    bench_crc_rate("crc32 software", 1);
+    bench_crc_rate("crc16 dma", 2);
+    bench_crc_rate("crc16 software", 3);
+#endif
+}
@@ -0,0 +1,11 @@
+/**
+ * Benchmarks executados no boot quando o projeto é configurado com
+ * -DBENCHMARK=ON. Os resultados saem pela serial (stdio).
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+void bench_run(void);
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * Números grandes (fonte de 7 segmentos, 16 pixels de altura)
+ */
+
+#include <string.h>
+#include "ssd1306.h"
+#include "bigfont.h"
+#include "seg7_font.h"
+
+// Índice do glifo em seg7_font.h (caracteres sem glifo viram espaço)
+static int glyph_index(char ch) {
+    const char *p = strchr(seg7_chars, ch);
+    if (ch == '\0' || p == NULL) p = strchr(seg7_chars, ' ');
+    return p - seg7_chars;
+}
+
+int bigfont_char_width(char ch) {
+    return seg7_width[glyph_index(ch)];
+}
+
+int bigfont_text_width(const char *str) {
+    int w = 0;
+    while (*str) w += bigfont_char_width(*str++);
+    return w;
+}
+
+int bigfont_draw_char(uint8_t *buf, int16_t x, uint8_t page, char ch) {
+    int idx = glyph_index(ch);
+    int w = seg7_width[idx];
+    const uint8_t *strip = seg7_strips + seg7_offset[idx];
+
+    for (int p = 0; p < SEG7_PAGES; p++, strip += w) {
+        if (page + p >= (int)SSD1306_NUM_PAGES) break;
+        uint8_t *dst = buf + (page + p) * SSD1306_WIDTH;
+        for (int c = 0; c < w; c++) {
+            if (x + c >= 0 && x + c < SSD1306_WIDTH) dst[x + c] = strip[c];
+        }
+    }
+    ssd1306_mark_dirty(x, x + w - 1, page, page + SEG7_PAGES - 1);
+    return w;
+}
+
+int bigfont_draw_string(uint8_t *buf, int16_t x, uint8_t page, const char *str) {
+    int16_t x0 = x;
+    while (*str) x += bigfont_draw_char(buf, x, page, *str++);
+    return x - x0;
+}
+
+// Invalida o conteúdo guardado (o framebuffer foi redesenhado por inteiro)
+void bigfont_field_reset(bigfont_field_t *f) {
+    f->len = 0;
+}
+
+void bigfont_field_update(bigfont_field_t *f, uint8_t *buf, const char *str) {
+    int n = strlen(str);
+    if (n > BIGFONT_MAX_CHARS) n = BIGFONT_MAX_CHARS;
+
+    char chars[BIGFONT_MAX_CHARS];
+    int16_t xs[BIGFONT_MAX_CHARS];
+    int16_t x = f->x_right;
+    for (int i = n - 1; i >= 0; i--) {
+        chars[i] = str[i];
+        x -= bigfont_char_width(str[i]);
+        xs[i] = x;
+    }
+
+    // Compara glifo a glifo a partir da direita: só redesenha o que mudou
+    for (int i = 0; i < n; i++) {
+        int j = f->len - (n - i);
+        if (j >= 0 && f->chars[j] == chars[i] && f->xs[j] == xs[i]) continue;
+        bigfont_draw_char(buf, xs[i], f->page, chars[i]);
+    }
+
+    // O campo encolheu: apaga as colunas que ficaram à esquerda
+    int16_t old_x0 = f->len ? f->xs[0] : f->x_right;
+    int16_t new_x0 = n ? xs[0] : f->x_right;
+    for (int16_t c = old_x0 < 0 ? 0 : old_x0; c < new_x0; c++) {
+        for (int p = 0; p < SEG7_PAGES && f->page + p < (int)SSD1306_NUM_PAGES; p++) {
+            buf[(f->page + p) * SSD1306_WIDTH + c] = 0;
+        }
+    }
+    if (old_x0 < new_x0) ssd1306_mark_dirty(old_x0, new_x0 - 1, f->page, f->page + SEG7_PAGES - 1);
+
+    f->len = n;
+    memcpy(f->chars, chars, n);
+    memcpy(f->xs, xs, n * sizeof(xs[0]));
+}
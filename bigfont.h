@@ -0,0 +1,35 @@
+/**
+ * Números grandes (fonte de 7 segmentos, 16 pixels de altura)
+ *
+ * Os glifos vêm prontos em tiras de colunas por página (seg7_font.h), então
+ * desenhar um glifo é copiar bytes. O campo numérico guarda o que já está
+ * desenhado e, a cada atualização, redesenha só os glifos que mudaram,
+ * marcando apenas as colunas deles para o envio parcial ao display.
+ */
+
+#ifndef BIGFONT_H
+#define BIGFONT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BIGFONT_MAX_CHARS 8
+
+// Campo numérico alinhado à direita
+typedef struct {
+    int16_t x_right;                // Coluna logo após o fim do campo
+    uint8_t page;                   // Página de cima (o campo ocupa 2 páginas)
+    uint8_t len;                    // Glifos desenhados atualmente
+    char chars[BIGFONT_MAX_CHARS];
+    int16_t xs[BIGFONT_MAX_CHARS];  // Coluna inicial de cada glifo
+} bigfont_field_t;
+
+int bigfont_char_width(char ch);
+int bigfont_text_width(const char *str);
+int bigfont_draw_char(uint8_t *buf, int16_t x, uint8_t page, char ch);
+int bigfont_draw_string(uint8_t *buf, int16_t x, uint8_t page, const char *str);
+
+void bigfont_field_reset(bigfont_field_t *f);
+void bigfont_field_update(bigfont_field_t *f, uint8_t *buf, const char *str);
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * Desenho de bitmaps (blit) no framebuffer do SSD1306
+ *
+ * Formato RLE (decodificado durante o desenho, sem buffer intermediário):
+ *   byte de controle c < 0x80  -> seguem c+1 bytes literais
+ *   byte de controle c >= 0x80 -> o próximo byte se repete (c & 0x7F)+1 vezes
+ * Os bitmaps comprimidos são gerados por tools/rle_encode.py.
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "ssd1306.h"
+#include "blit.h"
+
+static int dma_chan = -1; // Canal de DMA das cópias (-1 = usa memcpy)
+
+// Estado do decodificador RLE
+typedef struct {
+    const uint8_t *p;
+    uint8_t run;        // Bytes restantes na sequência atual
+    bool repeat;        // Sequência de repetição (true) ou literal (false)
+    uint8_t value;      // Byte repetido
+} rle_reader_t;
+
+static inline uint8_t rle_next(rle_reader_t *r) {
+    if (r->run == 0) {
+        uint8_t c = *r->p++;
+        r->repeat = c & 0x80;
+        r->run = (c & 0x7F) + 1;
+        if (r->repeat) r->value = *r->p++;
+    }
+    r->run--;
+    return r->repeat ? r->value : *r->p++;
+}
+
+// Combina um byte (já deslocado) com o framebuffer; mask indica os pixels cobertos
+static inline void blit_byte(uint8_t *dst, uint8_t bits, uint8_t mask, blit_mode_t mode) {
+    switch (mode) {
+        case BLIT_COPY: *dst = (*dst & ~mask) | bits; break;
+        case BLIT_OR:   *dst |= bits;                 break;
+        case BLIT_AND:  *dst &= bits | ~mask;         break;
+        case BLIT_XOR:  *dst ^= bits;                 break;
+    }
+}
+
+// Caminho rápido: bitmap sem RLE, alinhado em página e totalmente visível
+static void blit_copy_aligned(uint8_t *buf, int16_t x, int16_t page, const bitmap_t *bmp) {
+    int pages = bmp->height / 8;
+    uint8_t *dst = buf + page * SSD1306_WIDTH + x;
+
+    // Bitmap da largura da tela: as páginas são contíguas, uma única transferência
+    if (bmp->width == SSD1306_WIDTH) {
+        fb_copy_dma_start(dst, bmp->data, pages * SSD1306_WIDTH);
+        fb_copy_dma_wait();
+        return;
+    }
+
+    for (int p = 0; p < pages; p++) {
+        if (bmp->width >= BLIT_DMA_MIN_LEN) {
+            fb_copy_dma_start(dst, bmp->data + p * bmp->width, bmp->width);
+            fb_copy_dma_wait();
+        } else {
+            memcpy(dst, bmp->data + p * bmp->width, bmp->width);
+        }
+        dst += SSD1306_WIDTH;
+    }
+}
+
+void blit_dma_init(void) {
+    if (dma_chan < 0) dma_chan = dma_claim_unused_channel(false);
+}
+
+void fb_copy_dma_start(void *dst, const void *src, size_t len) {
+    if (dma_chan < 0) {
+        memcpy(dst, src, len);
+        return;
+    }
+    // Transferências de 32 bits quando origem, destino e tamanho permitem
+    bool words = (((uintptr_t)dst | (uintptr_t)src | len) & 3) == 0;
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, words ? DMA_SIZE_32 : DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    dma_channel_configure(dma_chan, &c, dst, src, words ? len / 4 : len, true);
+}
+
+void fb_copy_dma_wait(void) {
+    if (dma_chan >= 0) dma_channel_wait_for_finish_blocking(dma_chan);
+}
+
+void blit(uint8_t *buf, int16_t x, int16_t y, const bitmap_t *bmp, blit_mode_t mode) {
+    int w = bmp->width;
+    int pages = (bmp->height + 7) / 8;
+
+    if (!bmp->rle && mode == BLIT_COPY && (y & 7) == 0 && (bmp->height & 7) == 0 &&
+        x >= 0 && y >= 0 && x + w <= SSD1306_WIDTH && y + bmp->height <= SSD1306_HEIGHT) {
+        blit_copy_aligned(buf, x, y / 8, bmp);
+        return;
+    }
+
+    // Cada página do bitmap cai em até duas páginas do framebuffer
+    int shift = y & 7;
+    int page0 = (y - shift) / 8;
+
+    // Colunas visíveis
+    int c0 = x < 0 ? -x : 0;
+    int c1 = x + w > SSD1306_WIDTH ? SSD1306_WIDTH - x : w;
+
+    rle_reader_t rd = { .p = bmp->data };
+    const uint8_t *src = bmp->data;
+
+    for (int p = 0; p < pages; p++, src += w) {
+        int lo_page = page0 + p;
+        int hi_page = lo_page + 1;
+        bool lo_vis = lo_page >= 0 && lo_page < (int)SSD1306_NUM_PAGES;
+        bool hi_vis = shift && hi_page >= 0 && hi_page < (int)SSD1306_NUM_PAGES;
+
+        // Última página parcial: só as linhas que pertencem ao bitmap
+        uint8_t pmask = (p == pages - 1 && (bmp->height & 7)) ? (1u << (bmp->height & 7)) - 1 : 0xFF;
+        uint8_t lo_mask = pmask << shift;
+        uint8_t hi_mask = pmask >> (8 - shift);
+
+        uint8_t *lo = buf + lo_page * SSD1306_WIDTH + x;
+        uint8_t *hi = lo + SSD1306_WIDTH;
+
+        if (bmp->rle) {
+            // O fluxo comprimido é sequencial: colunas recortadas ainda são decodificadas
+            for (int c = 0; c < w; c++) {
+                uint8_t b = rle_next(&rd) & pmask;
+                if (c < c0 || c >= c1) continue;
+                if (lo_vis) blit_byte(&lo[c], b << shift, lo_mask, mode);
+                if (hi_vis) blit_byte(&hi[c], b >> (8 - shift), hi_mask, mode);
+            }
+            continue;
+        }
+
+        if (!lo_vis && !hi_vis) continue;
+        for (int c = c0; c < c1; c++) {
+            uint8_t b = src[c] & pmask;
+            if (lo_vis) blit_byte(&lo[c], b << shift, lo_mask, mode);
+            if (hi_vis) blit_byte(&hi[c], b >> (8 - shift), hi_mask, mode);
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * Desenho de bitmaps (blit) no framebuffer do SSD1306
+ *
+ * Os bitmaps usam a mesma organização do framebuffer: bytes verticais de 8
+ * pixels (bit 0 = linha de cima), página a página, coluna a coluna. É o
+ * formato de raspberry26x32.h e da fonte, então nenhum dado precisa ser
+ * convertido antes de desenhar.
+ */
+
+#ifndef BLIT_H
+#define BLIT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Modos de combinação do bitmap com o conteúdo já existente no framebuffer
+typedef enum {
+    BLIT_COPY,  // Substitui os pixels cobertos pelo bitmap
+    BLIT_OR,    // Acende os pixels acesos do bitmap
+    BLIT_AND,   // Mantém apenas os pixels acesos nos dois
+    BLIT_XOR    // Inverte os pixels acesos do bitmap
+} blit_mode_t;
+
+// Bitmap organizado em páginas
+typedef struct {
+    const uint8_t *data;
+    uint8_t width;      // Largura em pixels (colunas)
+    uint8_t height;     // Altura em pixels
+    bool rle;           // true = data comprimido em RLE (ver blit.c)
+} bitmap_t;
+
+// Comprimento mínimo de linha para valer a pena usar DMA no caminho alinhado
+#define BLIT_DMA_MIN_LEN 32
+
+void blit_dma_init(void);
+void blit(uint8_t *buf, int16_t x, int16_t y, const bitmap_t *bmp, blit_mode_t mode);
+
+// Cópia de memória por DMA (usada pelo caminho alinhado do blit)
+void fb_copy_dma_start(void *dst, const void *src, size_t len);
+void fb_copy_dma_wait(void);
+
+#endif
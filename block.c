@@ -0,0 +1,58 @@
+/**
+ * Pool de blocos de amostras e filas de referências
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "block.h"
+#include "pool.h"
+
+volatile block_stats_t block_stats;
+
+static spin_lock_t *lock;
+static uint32_t next_seq = 0;
+
+void block_init(void) {
+    lock = spin_lock_instance(spin_lock_claim_unused(true));
+}
+
+block_t *block_alloc(void) {
+    block_t *b = pool_alloc(POOL_SAMPLES);
+    if (b) {
+        b->refs = 1;                    // Referência do produtor
+        b->seq = next_seq++;            // Só o produtor aloca
+        b->n = 0;
+    }
+    return b;
+}
+
+void block_release(block_t *b) {
+    uint32_t irq = spin_lock_blocking(lock);
+    bool last = --b->refs == 0;
+    spin_unlock(lock, irq);
+    if (last) pool_free(POOL_SAMPLES, b);
+}
+
+void block_publish(block_t *b, block_queue_t *const *queues, uint32_t n) {
+    uint32_t irq = spin_lock_blocking(lock);
+    for (uint32_t i = 0; i < n; i++) {
+        block_queue_t *q = queues[i];
+        if (!block_ring_space(&q->ring)) {
+            q->drops++;                 // Consumidor atrasado perde este bloco
+            continue;
+        }
+        b->refs++;                      // Contada antes de o consumidor a ver
+        block_ring_push(&q->ring, b);
+    }
+    bool last = --b->refs == 0;         // Solta a referência do produtor
+    block_stats.published++;
+    spin_unlock(lock, irq);
+    if (last) pool_free(POOL_SAMPLES, b);   // Nenhum consumidor recebeu
+}
+
+// Só o consumidor da fila retira: sem trava
+block_t *block_queue_pop(block_queue_t *q) {
+    block_t *b = NULL;
+    block_ring_pop(&q->ring, &b);
+    return b;
+}
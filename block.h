@@ -0,0 +1,66 @@
+/**
+ * Blocos de amostras com contagem de referências
+ *
+ * A aquisição preenche um bloco de tamanho fixo e o publica para os
+ * consumidores (log e telemetria) passando só o ponteiro: cada consumidor
+ * recebe uma referência pela sua fila, lê o bloco no lugar e o devolve com
+ * block_release(); o último a devolver o libera para o pool. Nenhum estágio
+ * copia as amostras.
+ *
+ * Cada fila tem um produtor (a aquisição) e um consumidor, então é um ring
+ * SPSC de ring.h e o consumidor retira sem trava. O Cortex-M0+ não tem
+ * LDREX/STREX, então não há atômicos de verdade: a contagem de referências
+ * e a entrega às filas são trechos de poucas instruções sob um spin lock de
+ * hardware do SIO (com as interrupções do núcleo desligadas), seguros entre
+ * os dois núcleos e as interrupções e sem espera que dependa de outro
+ * estágio. Os blocos vêm do pool POOL_SAMPLES (pool.h), que conta
+ * a ocupação e as falhas. Pool vazio ou fila cheia não bloqueiam: a
+ * aquisição perde o bloco (falha do pool) ou o consumidor atrasado perde a
+ * sua referência (descarte).
+ */
+
+#ifndef BLOCK_H
+#define BLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ring.h"
+
+#define BLOCK_SAMPLES   32      // Amostras por bloco (16 s a 500 ms)
+#define BLOCK_COUNT     6       // Blocos no pool (POOL_SAMPLES)
+#define BLOCK_QUEUE_LEN 4       // Referências pendentes por consumidor (potência de 2)
+
+typedef struct {
+    uint16_t code;              // Código bruto do conversor
+    int16_t centi;              // Temperatura bruta (centésimos de °C)
+} block_sample_t;
+
+typedef struct {
+    uint32_t seq;               // Número do bloco desde o boot
+    uint32_t t0_ms;             // Instante da primeira amostra
+    uint16_t n;                 // Amostras preenchidas
+    uint8_t refs;               // Referências em uso (0 = livre)
+    block_sample_t samples[BLOCK_SAMPLES];
+} block_t;
+
+RING_DEFINE(block_ring, block_t *, BLOCK_QUEUE_LEN)
+
+typedef struct {
+    block_ring_t ring;
+    uint32_t drops;             // Referências perdidas com a fila cheia
+} block_queue_t;
+
+typedef struct {
+    uint32_t published;         // Blocos publicados
+} block_stats_t;
+
+extern volatile block_stats_t block_stats;
+
+void block_init(void);
+block_t *block_alloc(void);                 // NULL com o pool vazio
+void block_release(block_t *b);             // O último libera para o pool
+// Entrega uma referência a cada fila e solta a do produtor
+void block_publish(block_t *b, block_queue_t *const *queues, uint32_t n);
+block_t *block_queue_pop(block_queue_t *q); // NULL com a fila vazia
+
+#endif
@@ -0,0 +1,234 @@
+/**
+ * Controle do soprador (liga/desliga ou PID em ponto fixo) num alarme de
+ * hardware de alta prioridade
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "control.h"
+#include "log.h"
+
+// Modo inicial (configurado no CMake: off, onoff ou pid)
+#ifndef CONTROL_MODE
+#define CONTROL_MODE CONTROL_OFF
+#endif
+
+// Ganhos (não negativos) em ponto fixo, arredondados. O integral usa Q24:
+// por execução o ki é pequeno (ki = 0,1 vira 0,0001 por centésimo de °C) e
+// em Q16 perderia 8% ou zeraria abaixo de ~0,015
+#define Q16(x) ((int32_t)((x) * 65536.0f + 0.5f))
+#define Q24(x) ((int32_t)((x) * 16777216.0f + 0.5f))
+
+volatile control_stats_t control_stats;
+
+control_config_t control_config = {
+    .mode = CONTROL_MODE,
+    .action = CONTROL_COOL,
+    .setpoint = 60.0f,              // Acima disso a leira perde micro-organismos
+    .hysteresis = 4.0f,
+    .kp = 200.0f,                   // 20% de soprador por °C acima do alvo
+    .ki = 0.5f,
+    .kd = 0.0f,
+    .min_on_s = 60,
+    .min_off_s = 120,
+};
+
+// Parâmetros do laço em inteiros (só lidos pela interrupção)
+typedef struct {
+    uint8_t mode;
+    int8_t sign;                    // +1 resfriando, -1 aquecendo
+    int32_t setpoint;               // Centésimos de °C
+    int32_t half_hyst;
+    int32_t kp, kd;                 // Q16, por centésimo de °C e por execução
+    int32_t ki;                     // Q24, idem
+    uint32_t min_on, min_off;       // Execuções
+} loop_params_t;
+
+static loop_params_t params;
+static int alarm_num;
+static uint64_t target_us;
+
+static volatile int32_t input;      // Temperatura filtrada (centésimos de °C)
+static volatile bool input_valid = false;
+
+// Estado do laço
+static int64_t integral;            // Q24, em unidades da saída
+static int32_t last_input;
+static int32_t deriv;               // Derivada filtrada (centésimos por execução, Q4)
+static bool relay_on = false;
+static uint32_t state_ticks = 0;
+static bool started = false;
+
+static void output_set(uint16_t out) {
+    control_stats.output = out;
+    pwm_set_gpio_level(CONTROL_PIN, out);
+}
+
+static uint16_t onoff_step(int32_t e) {
+    state_ticks++;
+    if (relay_on && state_ticks >= params.min_on && e < -params.half_hyst) {
+        relay_on = false;
+        state_ticks = 0;
+    } else if (!relay_on && state_ticks >= params.min_off && e > params.half_hyst) {
+        relay_on = true;
+        state_ticks = 0;
+    }
+    return relay_on ? CONTROL_OUT_MAX : 0;
+}
+
+static uint16_t pid_step(int32_t e, int32_t x) {
+    // Derivada sobre a medida (sem salto na troca do alvo), filtrada em 1/8:
+    // a entrada só muda a cada amostra, não a cada execução
+    if (!started) last_input = x;
+    deriv += ((x - last_input) * 16 - deriv) >> 3;
+    last_input = x;
+
+    int64_t p = (int64_t)params.kp * e;
+    int64_t d = -(int64_t)params.kd * params.sign * deriv / 16;
+    int64_t i_new = integral + (int64_t)params.ki * e;
+    int64_t u = ((p + d) * 256 + i_new) >> 24;
+
+    // Anti-windup: o integrador não anda no sentido em que a saída já está
+    // saturada ou presa pelos tempos mínimos, e fica sempre dentro da faixa
+    // da saída
+    state_ticks++;
+    bool held = relay_on ? state_ticks < params.min_on && e < 0 : state_ticks < params.min_off && e > 0;
+    if (!((u > CONTROL_OUT_MAX && e > 0) || (u < 0 && e < 0) || held)) integral = i_new;
+    if (integral < 0) integral = 0;
+    if (integral > ((int64_t)CONTROL_OUT_MAX << 24)) integral = (int64_t)CONTROL_OUT_MAX << 24;
+
+    u = ((p + d) * 256 + integral) >> 24;
+    u = u < 0 ? 0 : u > CONTROL_OUT_MAX ? CONTROL_OUT_MAX : u;
+
+    // Saída mínima com histerese: parte com CONTROL_PID_START e gira pelo
+    // menos em CONTROL_PID_MIN até o PID pedir menos que isso, respeitando
+    // os tempos mínimos. Sem isso, perto do alvo a saída pisca entre 0 e
+    // poucos pontos e o soprador (ou o relé) parte a cada poucos segundos
+    if (relay_on && u < CONTROL_PID_MIN && state_ticks >= params.min_on) {
+        relay_on = false;
+        state_ticks = 0;
+    } else if (!relay_on && u >= CONTROL_PID_START && state_ticks >= params.min_off) {
+        relay_on = true;
+        state_ticks = 0;
+    }
+    if (!relay_on) return 0;
+    return u < CONTROL_PID_MIN ? CONTROL_PID_MIN : (uint16_t)u;
+}
+
+// Alarme de hardware: uma execução do laço a cada CONTROL_PERIOD_MS
+static void control_isr(uint alarm) {
+    uint32_t late = (uint32_t)(time_us_64() - target_us);
+    // Alvo absoluto; se a execução atrasou mais de um período (flash com as
+    // interrupções desligadas), as execuções perdidas são puladas
+    do {
+        target_us += CONTROL_PERIOD_MS * 1000;
+    } while (hardware_alarm_set_target(alarm, from_us_since_boot(target_us)));
+
+    control_stats.jitter_us = late;
+    if (late > control_stats.jitter_max_us) control_stats.jitter_max_us = late;
+    control_stats.ticks++;
+
+    if (!input_valid || params.mode == CONTROL_OFF) {
+        // Sem medida: saída desligada e estado zerado
+        integral = 0;
+        relay_on = false;
+        state_ticks = 0;
+        started = false;
+        output_set(0);
+        return;
+    }
+    int32_t x = input;
+    int32_t e = params.sign * (x - params.setpoint);
+    control_stats.error = e;
+    output_set(params.mode == CONTROL_ONOFF ? onoff_step(e) : pid_step(e, x));
+    started = true;
+}
+
+void control_configure(const control_config_t *cfg) {
+    loop_params_t p = {
+        .mode = cfg->mode,
+        .sign = cfg->action == CONTROL_HEAT ? -1 : 1,
+        .setpoint = (int32_t)(cfg->setpoint * 100.0f),
+        .half_hyst = (int32_t)(cfg->hysteresis * 50.0f),
+        .kp = Q16(cfg->kp / 100.0f),
+        .ki = Q24(cfg->ki / 100.0f * CONTROL_PERIOD_MS / 1000.0f),
+        .kd = Q16(cfg->kd / 100.0f * 1000.0f / CONTROL_PERIOD_MS),
+        .min_on = cfg->min_on_s * 1000u / CONTROL_PERIOD_MS,
+        .min_off = cfg->min_off_s * 1000u / CONTROL_PERIOD_MS,
+    };
+    uint32_t irq = save_and_disable_interrupts();
+    if (p.mode != params.mode || p.sign != params.sign) {
+        integral = 0;               // Outro modo: recomeça sem memória
+        started = false;
+    }
+    params = p;
+    control_config = *cfg;
+    restore_interrupts(irq);
+}
+
+static bool in_range(float v, float lo, float hi) {
+    return v >= lo && v <= hi;
+}
+
+// Quadro 'K': configuração nova (ou só a consulta, sem conteúdo); a resposta
+// traz a configuração em uso
+void control_frame(const uint8_t *f, uint32_t len) {
+    if (len == 1 + sizeof(control_config_t)) {
+        control_config_t cfg;
+        memcpy(&cfg, f + 1, sizeof(cfg));
+        // Comparações que falham com NaN: valores fora da faixa (ou não
+        // finitos) estourariam as conversões para inteiro
+        if (cfg.mode > CONTROL_PID || cfg.action > CONTROL_HEAT ||
+            !in_range(cfg.setpoint, CONTROL_SETPOINT_MIN, CONTROL_SETPOINT_MAX) ||
+            !in_range(cfg.hysteresis, 0.0f, CONTROL_HYST_MAX) || !in_range(cfg.kp, 0.0f, CONTROL_GAIN_MAX) ||
+            !in_range(cfg.ki, 0.0f, CONTROL_GAIN_MAX) || !in_range(cfg.kd, 0.0f, CONTROL_GAIN_MAX)) {
+            LOG("CTL erro-config");
+            return;
+        }
+        control_configure(&cfg);
+    } else if (len != 1) {
+        LOG("CTL erro-tamanho");
+        return;
+    }
+    const control_config_t *c = &control_config;
+    LOG("CTL ok modo=%s acao=%u alvo=%.2f hist=%.2f min=%u/%u", control_mode_name(c->mode),
+        c->action, c->setpoint, c->hysteresis, c->min_on_s, c->min_off_s);
+    LOG("CTL pid kp=%.3f ki=%.4f kd=%.3f", c->kp, c->ki, c->kd);
+}
+
+void control_set_input(int32_t centi_celsius, bool valid) {
+    input = centi_celsius;
+    input_valid = valid;
+}
+
+void control_init(void) {
+    gpio_set_function(CONTROL_PIN, GPIO_FUNC_PWM);
+    uint slice = pwm_gpio_to_slice_num(CONTROL_PIN);
+    pwm_config cfg = pwm_get_default_config();
+    pwm_config_set_clkdiv(&cfg, CONTROL_PWM_DIV);
+    pwm_config_set_wrap(&cfg, CONTROL_OUT_MAX - 1);
+    pwm_init(slice, &cfg, true);
+    output_set(0);
+
+    control_configure(&control_config);
+
+    // Alarme próprio acima de todas as outras interrupções
+    alarm_num = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm_num, control_isr);
+    irq_set_priority(hardware_alarm_get_irq_num(alarm_num), PICO_HIGHEST_IRQ_PRIORITY);
+    target_us = time_us_64() + CONTROL_PERIOD_MS * 1000;
+    hardware_alarm_set_target(alarm_num, from_us_since_boot(target_us));
+}
+
+const char *control_mode_name(control_mode_t mode) {
+    switch (mode) {
+        case CONTROL_OFF:   return "DESLIGADO";
+        case CONTROL_ONOFF: return "LIGA/DESL";
+        case CONTROL_PID:   return "PID";
+        default:            return "--";
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * Controle do soprador de aeração (ou aquecedor) pela temperatura filtrada
+ *
+ * O laço roda num alarme de hardware próprio, com a maior prioridade de
+ * interrupção e alvo absoluto (alvo += período, sem deriva), então o
+ * período e o jitter não dependem do display, do I2C nem da USB; o jitter
+ * medido (atraso da entrada na interrupção em relação ao alvo) só cresce
+ * nos trechos com interrupções desligadas, e a gravação da flash (~50 ms)
+ * aparece no máximo da telemetria. Toda a conta do laço é inteira.
+ *
+ * Modos:
+ *  - CONTROL_ONOFF: liga acima de setpoint + hist/2 e desliga abaixo de
+ *    setpoint - hist/2, respeitando os tempos mínimos ligado e desligado;
+ *  - CONTROL_PID: PID em ponto fixo (Q16, o integral em Q24) com saída PWM de 0 a
+ *    CONTROL_OUT_MAX, derivada sobre a medida (filtrada) e anti-windup por
+ *    integração condicional com o integrador limitado à faixa da saída. A
+ *    saída tem um mínimo com histerese (parte em CONTROL_PID_START, para
+ *    abaixo de CONTROL_PID_MIN) e os mesmos tempos mínimos ligado e
+ *    desligado, para não ligar e desligar o soprador perto do alvo.
+ * Com a ação CONTROL_COOL (soprador) a saída sobe com a temperatura; com
+ * CONTROL_HEAT, desce. Sem medida válida (sensor em falha) a saída é zero.
+ *
+ * O ajuste é feito ao vivo pelo tools/control.py (quadro 'K' da USB); a
+ * configuração é convertida para ponto fixo no loop principal e trocada de
+ * uma vez, com as interrupções desligadas.
+ */
+
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CONTROL_PIN         13      // MOSFET do soprador / relé (PWM)
+#define CONTROL_PERIOD_MS   100     // Período do laço
+#define CONTROL_OUT_MAX     1000    // Saída máxima (0,1% de PWM)
+#define CONTROL_PWM_DIV     125.0f  // 1 MHz de contagem: PWM de 1 kHz
+#define CONTROL_SETPOINT_MIN -20.0f  // Faixas aceitas pelo quadro 'K'
+#define CONTROL_SETPOINT_MAX 120.0f
+#define CONTROL_HYST_MAX    20.0f
+#define CONTROL_GAIN_MAX    10000.0f // kp, ki e kd
+#define CONTROL_PID_START   200     // Saída do PID para o soprador partir (20%)
+#define CONTROL_PID_MIN     50      // Menor saída com ele girando (5%)
+
+typedef enum {
+    CONTROL_OFF,
+    CONTROL_ONOFF,
+    CONTROL_PID,
+} control_mode_t;
+
+typedef enum {
+    CONTROL_COOL,                   // Saída sobe com a temperatura (soprador)
+    CONTROL_HEAT,                   // Saída sobe com o frio (aquecedor)
+} control_action_t;
+
+// Configuração (também o conteúdo do quadro 'K', little-endian)
+typedef struct {
+    uint8_t mode;                   // control_mode_t
+    uint8_t action;                 // control_action_t
+    uint16_t reserved;
+    float setpoint;                 // °C
+    float hysteresis;               // °C (liga/desliga)
+    float kp;                       // Saída (0..1000) por °C
+    float ki;                       // Saída por °C·s
+    float kd;                       // Saída por °C/s
+    uint16_t min_on_s;              // Tempos mínimos ligado e desligado
+    uint16_t min_off_s;
+} control_config_t;
+
+typedef struct {
+    uint16_t output;                // Saída atual (0..CONTROL_OUT_MAX)
+    int32_t error;                  // Erro (centésimos de °C, já com a ação)
+    uint32_t ticks;                 // Execuções do laço
+    uint32_t jitter_us;             // Atraso da última execução
+    uint32_t jitter_max_us;         // Maior atraso desde a última leitura
+} control_stats_t;
+
+extern volatile control_stats_t control_stats;
+extern control_config_t control_config;
+
+void control_init(void);
+void control_configure(const control_config_t *cfg);     // Loop principal
+void control_set_input(int32_t centi_celsius, bool valid); // Timer de amostragem
+void control_frame(const uint8_t *f, uint32_t len);     // Quadro 'K' (sem o CRC)
+const char *control_mode_name(control_mode_t mode);
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * CRC pelo sniffer do DMA, com fallback em software
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "crc.h"
+
+#if PICO_ON_DEVICE
+#include "hardware/dma.h"
+#endif
+
+// Tabelas de 4 bits: 16 entradas cada, duas consultas por byte
+static const uint32_t crc32_nibble[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+static const uint16_t crc16_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+uint32_t crc32_sw(const void *src, size_t len) {
+    const uint8_t *p = src;
+    uint32_t crc = 0xFFFFFFFFu;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0xF];
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0xF];
+    }
+    return ~crc;
+}
+
+uint16_t crc16_sw(const void *src, size_t len, uint16_t crc) {
+    const uint8_t *p = src;
+    while (len--) {
+        uint8_t b = *p++;
+        crc = (uint16_t)(crc << 4) ^ crc16_nibble[(crc >> 12) ^ (b >> 4)];
+        crc = (uint16_t)(crc << 4) ^ crc16_nibble[(crc >> 12) ^ (b & 0xF)];
+    }
+    return crc;
+}
+
+#if PICO_ON_DEVICE
+
+static int dma_chan = -1;
+static uint8_t sink;                    // Destino fixo quando só se verifica
+
+void crc_init(void) {
+    if (dma_chan < 0) dma_chan = dma_claim_unused_channel(false);
+}
+
+// Cópia byte a byte com o sniffer no canal; devolve o acumulador
+static uint32_t sniff_copy(void *dst, const void *src, size_t len, uint mode, bool invert, uint32_t seed) {
+    dma_sniffer_enable(dma_chan, mode, true);
+    dma_sniffer_set_output_reverse_enabled(invert);
+    dma_sniffer_set_output_invert_enabled(invert);
+    dma_sniffer_set_data_accumulator(seed);
+
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, dst != NULL);
+    channel_config_set_sniff_enable(&c, true);
+    dma_channel_configure(dma_chan, &c, dst ? dst : &sink, src, len, true);
+    dma_channel_wait_for_finish_blocking(dma_chan);
+
+    uint32_t acc = dma_sniffer_get_data_accumulator();
+    dma_sniffer_disable();
+    return acc;
+}
+
+uint32_t crc32_copy(void *dst, const void *src, size_t len) {
+    if (dma_chan < 0 || len == 0) {
+        if (dst) memcpy(dst, src, len);
+        return crc32_sw(src, len);
+    }
+    // Dados com os bits refletidos e a saída refletida e invertida: zlib
+    return sniff_copy(dst, src, len, DMA_SNIFF_CTRL_CALC_VALUE_CRC32R, true, 0xFFFFFFFFu);
+}
+
+uint16_t crc16_copy(void *dst, const void *src, size_t len, uint16_t crc) {
+    if (dma_chan < 0 || len == 0) {
+        if (dst) memcpy(dst, src, len);
+        return crc16_sw(src, len, crc);
+    }
+    return sniff_copy(dst, src, len, DMA_SNIFF_CTRL_CALC_VALUE_CRC16, false, crc) & 0xFFFF;
+}
+
+#else
+
+void crc_init(void) {
+}
+
+uint32_t crc32_copy(void *dst, const void *src, size_t len) {
+    if (dst) memcpy(dst, src, len);
+    return crc32_sw(src, len);
+}
+
+uint16_t crc16_copy(void *dst, const void *src, size_t len, uint16_t crc) {
+    if (dst) memcpy(dst, src, len);
+    return crc16_sw(src, len, crc);
+}
+
+#endif
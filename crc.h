@@ -0,0 +1,34 @@
+/**
+ * CRC pelo sniffer do DMA (CRC-32 e CRC-16 calculados durante uma cópia)
+ *
+ * O sniffer do RP2040 observa os dados de um canal de DMA e acumula o CRC
+ * enquanto eles passam, então a cópia que já seria feita (o registro para a
+ * página da flash, o log para o quadro da serial) sai com o CRC sem custo
+ * de CPU. Com dst = NULL os dados só são lidos (verificação).
+ *  - CRC-32: o do zlib/Ethernet (refletido, semente e saída invertidas);
+ *  - CRC-16: CCITT-FALSE (0x1021, semente 0xFFFF, sem reflexão), que pode
+ *    continuar de um trecho para o outro passando o resultado anterior.
+ *
+ * O sniffer é um só: usar apenas do loop principal. Sem canal de DMA livre
+ * ou fora do dispositivo (PICO_ON_DEVICE = 0) as versões em software, por
+ * tabelas de 4 bits, fazem o mesmo cálculo.
+ */
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define CRC16_INIT 0xFFFF
+
+void crc_init(void);
+
+uint32_t crc32_copy(void *dst, const void *src, size_t len);
+uint16_t crc16_copy(void *dst, const void *src, size_t len, uint16_t crc);
+
+// Versões em software (fallback e referência do benchmark)
+uint32_t crc32_sw(const void *src, size_t len);
+uint16_t crc16_sw(const void *src, size_t len, uint16_t crc);
+
+#endif
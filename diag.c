@@ -0,0 +1,106 @@
+/**
+ * Diagnóstico do sensor (faixa, travamento, ruído e falta de leituras)
+ */
+
+#include <math.h>
+#include "diag.h"
+#include "alarms.h"
+#include "screens.h"
+
+diag_t diag;
+
+static bool noise_valid = false;
+
+static void diag_set(diag_fault_t fault) {
+    if (fault != diag.fault) screens_notify(DATA_DIAG);
+    diag.fault = fault;
+    alarm_set(ALARM_SENSOR, fault != DIAG_OK);
+}
+
+// Resultado de uma leitura nova: true = a amostra pode ser usada
+static bool diag_accept(diag_fault_t fault) {
+    diag.missing = 0;
+    diag_set(fault);
+    bool ok = fault == DIAG_OK || fault == DIAG_NOISY;
+    if (!ok) diag.rejected++;
+    return ok;
+}
+
+// Chamada a cada código novo do backend (no callback do timer)
+bool diag_check(uint32_t code, uint8_t bits) {
+    uint32_t code16 = bits <= 16 ? code << (16 - bits) : code >> (bits - 16);
+    diag.bits = bits;
+
+    // 1. Faixa: terminal aberto ou em curto (não entra no ruído)
+    diag_fault_t fault = DIAG_OK;
+    if (code16 >= DIAG_OPEN_CODE16) fault = DIAG_OPEN;
+    else if (code16 <= DIAG_SHORT_CODE16) fault = DIAG_SHORT;
+
+    if (fault == DIAG_OK) {
+        // 2. Código repetido
+        if (code16 == diag.last_code16) {
+            if (diag.same_count < UINT16_MAX) diag.same_count++;
+        } else {
+            diag.same_count = 0;
+        }
+
+        // 3. Ruído pelas diferenças entre amostras vizinhas: var(d) = 2·σ²
+        if (noise_valid) {
+            float d = (float)code16 - (float)diag.last_code16;
+            diag.noise_var16 += (d * d * 0.5f - diag.noise_var16) / (1 << DIAG_NOISE_SHIFT);
+        }
+        noise_valid = true;
+        diag.last_code16 = code16;
+
+        if (diag.same_count >= DIAG_STUCK_SAMPLES) fault = DIAG_STUCK;
+        else if (diag.noise_var16 > DIAG_NOISE_MAX16 * DIAG_NOISE_MAX16) fault = DIAG_NOISY;
+    }
+
+    return diag_accept(fault);
+}
+
+// Sondas digitais: a cada temperatura nova (já conferida pelo CRC)
+bool diag_check_celsius(float celsius) {
+    diag_fault_t fault = DIAG_OK;
+    if (celsius < DIAG_CELSIUS_MIN || celsius > DIAG_CELSIUS_MAX) {
+        fault = DIAG_RANGE;
+    } else {
+        if (celsius == diag.last_celsius) {
+            if (diag.same_count < UINT16_MAX) diag.same_count++;
+        } else {
+            diag.same_count = 0;
+        }
+        diag.last_celsius = celsius;
+        if (diag.same_count >= DIAG_STUCK_CELSIUS) fault = DIAG_STUCK;
+    }
+    return diag_accept(fault);
+}
+
+// Período do timer em que o backend não entregou leitura
+void diag_no_data(bool fault) {
+    if (diag.missing < UINT16_MAX) diag.missing++;
+    if (fault || diag.missing >= DIAG_NO_DATA_PERIODS) diag_set(DIAG_NO_DATA);
+}
+
+bool diag_fault(void) {
+    return diag.fault != DIAG_OK && diag.fault != DIAG_NOISY;
+}
+
+float diag_noise_lsb(void) {
+    float rms = sqrtf(diag.noise_var16);
+    return diag.bits <= 16 ? rms / (1u << (16 - diag.bits)) : rms * (1u << (diag.bits - 16));
+}
+
+// Texto curto (4 caracteres) da tela de diagnóstico
+const char *diag_name(diag_fault_t fault) {
+    switch (fault) {
+        case DIAG_OK:    return "  OK";
+        case DIAG_OPEN:  return "ABER";
+        case DIAG_SHORT: return "CURT";
+        case DIAG_STUCK: return "TRAV";
+        case DIAG_NOISY: return "RUID";
+        case DIAG_RANGE: return "FAIX";
+        case DIAG_NO_DATA: return "FALT";
+        default:         return "  ??";
+    }
+}
@@ -0,0 +1,68 @@
+/**
+ * Diagnóstico do sensor a partir das leituras do backend
+ *
+ * Cada código novo de um backend analógico é verificado em tempo constante:
+ *  - fora da faixa: perto do fundo de escala (terminal aberto, puxado pelo
+ *    resistor de polarização) ou perto de zero (curto);
+ *  - travado: o mesmo código repetido por DIAG_STUCK_SAMPLES amostras;
+ *  - ruído: variância das diferenças entre amostras vizinhas (média
+ *    exponencial), que ignora a variação lenta da temperatura.
+ * As amostras com falha de faixa ou travadas ficam fora da média móvel; o
+ * ruído alto só é sinalizado. Os limites são em códigos de 16 bits, para
+ * valerem igual em qualquer backend. As sondas digitais (celsius = true)
+ * têm CRC próprio; delas só a temperatura fora da faixa plausível e o valor
+ * travado (numa janela maior, já que a sonda resolve 1/16 °C) são falhas.
+ *
+ * Em qualquer backend, DIAG_NO_DATA_PERIODS períodos seguidos sem leitura
+ * nova (conversor que não responde, sondas desligadas) também são falha:
+ * sem isso a última medida boa seria usada para sempre. Uma falha que o
+ * próprio backend informa (acq_backend_t.fault) vale na hora.
+ */
+
+#ifndef DIAG_H
+#define DIAG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DIAG_OPEN_CODE16    62259   // 95% do fundo de escala
+#define DIAG_SHORT_CODE16   1311    // 2% do fundo de escala
+#define DIAG_STUCK_SAMPLES  60      // 30 s no período normal
+#define DIAG_NOISE_MAX16    328.0f  // Ruído rms máximo (0,5% do fundo de escala)
+#define DIAG_NOISE_SHIFT    5       // Média exponencial de 1/32
+#define DIAG_NO_DATA_PERIODS 4      // Períodos sem leitura nova (o ciclo das sondas é ~0,9 s)
+#define DIAG_CELSIUS_MIN    -20.0f  // Faixa plausível das sondas digitais
+#define DIAG_CELSIUS_MAX    100.0f
+#define DIAG_STUCK_CELSIUS  2048    // ~30 min de ciclos das sondas com o mesmo valor
+
+typedef enum {
+    DIAG_OK,
+    DIAG_OPEN,
+    DIAG_SHORT,
+    DIAG_STUCK,
+    DIAG_NOISY,
+    DIAG_RANGE,                 // Sonda digital fora da faixa plausível
+    DIAG_NO_DATA,               // Sem leitura nova do backend
+} diag_fault_t;
+
+typedef struct {
+    uint8_t fault;              // diag_fault_t da última amostra
+    uint8_t bits;               // Resolução do backend (para exibir o ruído)
+    uint16_t same_count;        // Repetições do último código
+    uint32_t last_code16;
+    float last_celsius;
+    uint16_t missing;           // Períodos seguidos sem leitura nova
+    float noise_var16;          // Variância do ruído (códigos de 16 bits²)
+    uint32_t rejected;          // Amostras descartadas
+} diag_t;
+
+extern diag_t diag;
+
+bool diag_check(uint32_t code, uint8_t bits);  // false = descartar a amostra
+bool diag_check_celsius(float celsius);        // Idem, sondas digitais
+void diag_no_data(bool fault);                 // Período sem leitura nova (fault: falha do backend)
+bool diag_fault(void);                         // Falha que invalida a medida
+float diag_noise_lsb(void);                    // Ruído rms em LSB do backend
+const char *diag_name(diag_fault_t fault);
+
+#endif
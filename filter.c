@@ -0,0 +1,78 @@
+/**
+ * Filtros da temperatura (média móvel e média exponencial com alfa variável)
+ */
+
+#include <stdbool.h>
+#include <math.h>
+#include "filter.h"
+#include "lerp.h"
+#include "ring.h"
+
+filter_t filter = { .alpha_q8 = FILTER_ALPHA_MIN_Q8 };
+
+RING_DEFINE(avg_ring, int32_t, MOVING_AVG_RING)
+static avg_ring_t avg_history;  // Temperaturas da janela (milésimos de °C)
+static int32_t avg_sum = 0;     // Soma das temperaturas da janela
+
+static int32_t state;           // Saída (FILTER_SCALE por °C)
+static float last_x;
+static bool started = false;
+
+// Média móvel com a soma corrente: uma entrada e uma saída por amostra, em
+// vez de somar a janela inteira
+float filter_moving_average(float x) {
+    // 1. Armazena a temperatura nova em milésimos: a soma inteira não
+    // acumula erro de arredondamento
+    int32_t t = (int32_t)lroundf(x * 1000.0f);
+    avg_ring_push(&avg_history, t);
+    avg_sum += t;
+
+    // 2. Com a janela completa, a temperatura mais antiga sai da soma
+    int32_t old;
+    if (avg_ring_count(&avg_history) > MOVING_AVG_SIZE && avg_ring_pop(&avg_history, &old)) {
+        avg_sum -= old;
+    }
+
+    // 3. Calcula a média
+    return avg_sum / (avg_ring_count(&avg_history) * 1000.0f);
+}
+
+// Chamada a cada temperatura bruta válida (no callback do timer)
+float filter_adaptive(float x) {
+    int32_t xi = (int32_t)(x * FILTER_SCALE);
+    if (!started) {
+        state = xi;
+        last_x = x;
+        started = true;
+        return x;
+    }
+
+    // 1. Ruído da entrada pelas diferenças: var(d) = 2·σ². Diferenças acima
+    // de FILTER_CLIP desvios são degraus da temperatura, não ruído: entram
+    // limitadas, senão um degrau travaria o filtro no alfa mínimo
+    float d = x - last_x;
+    last_x = x;
+    float d2 = d * d * 0.5f;
+    float clip = FILTER_CLIP * FILTER_CLIP * filter.noise_var;
+    if (clip < FILTER_TARGET_C * FILTER_TARGET_C) clip = FILTER_TARGET_C * FILTER_TARGET_C;
+    if (d2 > clip) d2 = clip;
+    filter.noise_var += (d2 - filter.noise_var) / (1 << FILTER_NOISE_SHIFT);
+
+    // 2. Alfa que leva o ruído da saída ao alvo
+    float alpha = 1.0f;
+    if (filter.noise_var > 0.0f) {
+        float r = FILTER_TARGET_C * FILTER_TARGET_C / filter.noise_var;
+        alpha = 2.0f * r / (1.0f + r);
+    }
+    int32_t a = (int32_t)(alpha * 256.0f + 0.5f);
+    filter.alpha_q8 = a < FILTER_ALPHA_MIN_Q8 ? FILTER_ALPHA_MIN_Q8 : a > FILTER_ALPHA_MAX_Q8 ? FILTER_ALPHA_MAX_Q8 : a;
+
+    // 3. Média exponencial no interpolador (só o estado é guardado)
+    state = lerp_blend(state, xi, filter.alpha_q8);
+    return state / FILTER_SCALE;
+}
+
+// N da média móvel com o mesmo ruído de saída: α = 2 / (N + 1)
+uint16_t filter_window(void) {
+    return 512 / filter.alpha_q8 - 1;
+}
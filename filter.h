@@ -0,0 +1,47 @@
+/**
+ * Filtros da temperatura: média móvel fixa e adaptativo (média exponencial
+ * com alfa variável)
+ *
+ * A média móvel guarda a janela num ring (ring.h) em milésimos de °C, com a
+ * soma corrente: uma entrada e uma saída por amostra.
+ *
+ * A variância do ruído da temperatura bruta é estimada em tempo real pelas
+ * diferenças entre amostras vizinhas. Para ruído branco a saída de uma
+ * média exponencial tem variância σ²·α/(2-α), então o alfa que leva a saída
+ * a FILTER_TARGET_C é α = 2r/(1+r), com r = (alvo/σ)². Diferenças muito
+ * maiores que o ruído atual entram limitadas na estimativa, para que um
+ * degrau real da temperatura não seja confundido com ruído. Com pouco ruído o
+ * filtro quase não atrasa; com muito, chega a FILTER_ALPHA_MIN_Q8 (o
+ * equivalente à média móvel de 40 amostras). Como o estado é só a saída,
+ * trocar o alfa não causa transitório nem exige recalcular nada.
+ *
+ * Selecionado com -DFILTER_ADAPTIVE=ON; sem ele vale a média móvel fixa.
+ */
+
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdint.h>
+
+#define MOVING_AVG_SIZE     40      // Tamanho da janela para média móvel
+#define MOVING_AVG_RING     64      // Buffer da janela (potência de 2 acima dela)
+
+#define FILTER_TARGET_C     0.05f   // Ruído rms desejado na saída (°C)
+#define FILTER_ALPHA_MIN_Q8 12      // Alfa mínimo (12/256 ~ janela de 40)
+#define FILTER_ALPHA_MAX_Q8 255
+#define FILTER_NOISE_SHIFT  5       // Estimativa do ruído: média de 1/32
+#define FILTER_CLIP         4.0f    // Diferenças maiores (em desvios) são degraus
+#define FILTER_SCALE        10000.0f // Estado em décimos de milésimo de °C
+
+typedef struct {
+    float noise_var;            // Variância do ruído da entrada (°C²)
+    uint8_t alpha_q8;           // Alfa em uso (1/256)
+} filter_t;
+
+extern filter_t filter;
+
+float filter_moving_average(float x);
+float filter_adaptive(float x);
+uint16_t filter_window(void);   // Janela da média móvel equivalente
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * Histórico da temperatura filtrada (mínimo, máximo, média e tendência)
+ */
+
+#include <math.h>
+#include "history.h"
+#include "screens.h"
+
+history_t history = { .min = 1e9f, .max = -1e9f, .trend_dec = RATE_DEC(TREND_POINT_MS) };
+
+// Média como a tela de mínimo/máximo mostra (décimos de °C e de °F): só a
+// mudança desse valor redesenha a tela, não cada saída do filtro
+static int32_t mean_shown_c = INT32_MIN, mean_shown_f = INT32_MIN;
+
+static bool mean_shown_changed(float mean) {
+    int32_t c = (int32_t)lroundf(mean * 10.0f);
+    int32_t f = (int32_t)lroundf((mean * 9.0f / 5.0f + 32.0f) * 10.0f);
+    if (c == mean_shown_c && f == mean_shown_f) return false;
+    mean_shown_c = c;
+    mean_shown_f = f;
+    return true;
+}
+
+// Chamada a cada saída do filtro (no callback do timer)
+void history_add(float temp, uint32_t period_ms) {
+    uint32_t changed = 0;
+
+    if (temp < history.min) history.min = temp, changed = DATA_MINMAX;
+    if (temp > history.max) history.max = temp, changed = DATA_MINMAX;
+    history.count++;
+    history.mean += (temp - history.mean) / history.count; // Média incremental
+    if (mean_shown_changed(history.mean)) changed = DATA_MINMAX;
+
+    if (rate_dec_add(&history.trend_dec, temp, period_ms)) {
+        trend_ring_push(&history.trend, (int16_t)(history.trend_dec.mean * 100.0f));
+        // Só as últimas TREND_POINTS ficam: o ponto mais antigo sai
+        if (trend_ring_count(&history.trend) > TREND_POINTS) trend_ring_consume(&history.trend, 1);
+        changed |= DATA_TREND;
+    }
+
+    if (changed) screens_notify(changed);
+}
+
+int16_t history_trend_point(int age) {
+    return trend_ring_peek(&history.trend, age);
+}
+
+int history_trend_len(void) {
+    return trend_ring_count(&history.trend);
+}
@@ -0,0 +1,38 @@
+/**
+ * Histórico da temperatura filtrada para as telas de mínimo/máximo e de
+ * tendência. Atualizado a cada saída do filtro em tempo constante; os
+ * pontos da tendência são médias por tempo (rate.h), então não dependem da
+ * taxa de amostragem. As telas só processam esses dados quando estão
+ * visíveis.
+ */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+#include "rate.h"
+#include "ring.h"
+
+#define TREND_POINTS         120    // Pontos do gráfico de tendência (2 horas)
+#define TREND_POINT_MS       60000  // Período de cada ponto (média de 1 minuto)
+#define TREND_RING           128    // Buffer dos pontos (potência de 2 acima de TREND_POINTS)
+
+RING_DEFINE(trend_ring, int16_t, TREND_RING)
+
+typedef struct {
+    float min;
+    float max;
+    float mean;
+    uint32_t count;
+
+    trend_ring_t trend;             // Médias por minuto em centésimos de °C
+    rate_dec_t trend_dec;           // Média do ponto em formação
+} history_t;
+
+extern history_t history;
+
+void history_add(float temp, uint32_t period_ms);
+int16_t history_trend_point(int age);  // age = 0 é o ponto mais recente
+int history_trend_len(void);           // Pontos válidos
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * Gerenciador do barramento I2C (i2c_default)
+ *
+ * Cada transação vira uma sequência de palavras para o registrador
+ * DATA_CMD (byte + bits de leitura, RESTART e STOP), escrita por um canal
+ * de DMA; um segundo canal copia os bytes lidos. O fim é sinalizado pela
+ * interrupção STOP_DET, que também ocorre após um TX_ABRT (sem ACK), pois
+ * o controlador gera o STOP sozinho nesse caso.
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "i2c_bus.h"
+
+i2c_dev_stats_t i2c_bus_stats[I2C_DEV_COUNT];
+
+static i2c_inst_t *bus;
+static int tx_chan = -1, rx_chan = -1;
+static dma_channel_config tx_cfg, rx_cfg;
+
+static i2c_txn_t *queue_head[I2C_PRIO_COUNT];
+static i2c_txn_t *queue_tail[I2C_PRIO_COUNT];
+static i2c_txn_t *volatile current = NULL;
+static bool aborted = false;
+static uint32_t cmd[I2C_BUS_MAX_LEN];   // Palavras DATA_CMD da transação atual
+
+// Retira a transação de maior prioridade (chamada com interrupções desligadas)
+static i2c_txn_t *queue_pop(void) {
+    for (int p = 0; p < I2C_PRIO_COUNT; p++) {
+        i2c_txn_t *t = queue_head[p];
+        if (t) {
+            queue_head[p] = t->next;
+            if (!queue_head[p]) queue_tail[p] = NULL;
+            return t;
+        }
+    }
+    return NULL;
+}
+
+static void finish(i2c_txn_t *t, bool ok) {
+    uint32_t lat = time_us_32() - t->queued_us;
+    i2c_dev_stats_t *s = &i2c_bus_stats[t->dev];
+    s->txns++;
+    if (!ok) s->errors++;
+    if (lat > s->lat_max_us) s->lat_max_us = lat;
+    s->lat_avg_us = s->lat_avg_us ? s->lat_avg_us + ((int32_t)(lat - s->lat_avg_us) >> 4) : lat;
+
+    t->ok = ok;
+    t->busy = false;
+    if (t->done) t->done(t, ok);
+}
+
+// Inicia a próxima transação da fila (interrupções desligadas ou na IRQ)
+static void start_next(void) {
+    i2c_txn_t *t;
+    while ((t = queue_pop()) != NULL) {
+        uint32_t n = 0;
+        uint32_t len = (t->prefix >= 0) + t->tx_len + t->rx_len;
+        if (len == 0 || len > I2C_BUS_MAX_LEN) {
+            finish(t, false);
+            continue;
+        }
+
+        uint32_t wait = time_us_32() - t->queued_us;
+        if (wait > i2c_bus_stats[t->dev].wait_max_us) i2c_bus_stats[t->dev].wait_max_us = wait;
+
+        if (t->prefix >= 0) cmd[n++] = (uint8_t)t->prefix;
+        for (uint16_t i = 0; i < t->tx_len; i++) cmd[n++] = t->tx[i];
+        for (uint16_t i = 0; i < t->rx_len; i++) {
+            cmd[n] = I2C_IC_DATA_CMD_CMD_BITS;
+            if (i == 0 && n > 0) cmd[n] |= I2C_IC_DATA_CMD_RESTART_BITS;
+            n++;
+        }
+        cmd[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+        i2c_hw_t *hw = i2c_get_hw(bus);
+        hw->enable = 0;
+        hw->tar = t->addr;
+        hw->enable = 1;
+
+        current = t;
+        aborted = false;
+        if (t->rx_len) dma_channel_configure(rx_chan, &rx_cfg, t->rx, &hw->data_cmd, t->rx_len, true);
+        dma_channel_configure(tx_chan, &tx_cfg, &hw->data_cmd, cmd, n, true);
+        return;
+    }
+    current = NULL;
+}
+
+static void i2c_bus_irq(void) {
+    i2c_hw_t *hw = i2c_get_hw(bus);
+    uint32_t stat = hw->intr_stat;
+
+    if (stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        (void)hw->clr_tx_abrt;
+        dma_channel_abort(tx_chan);
+        dma_channel_abort(rx_chan);
+        aborted = true;
+    }
+
+    if (stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        (void)hw->clr_stop_det;
+        i2c_txn_t *t = current;
+        if (!t) return;
+        // O último byte lido pode ainda estar sendo copiado pelo DMA
+        if (!aborted && t->rx_len) {
+            while (dma_channel_is_busy(rx_chan)) tight_loop_contents();
+        }
+        current = NULL;
+        finish(t, !aborted);
+        start_next();
+    }
+}
+
+void i2c_bus_init(i2c_inst_t *i2c) {
+    bus = i2c;
+    i2c_hw_t *hw = i2c_get_hw(bus);
+
+    tx_chan = dma_claim_unused_channel(true);
+    tx_cfg = dma_channel_get_default_config(tx_chan);
+    channel_config_set_transfer_data_size(&tx_cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&tx_cfg, true);
+    channel_config_set_write_increment(&tx_cfg, false);
+    channel_config_set_dreq(&tx_cfg, i2c_get_dreq(bus, true));
+
+    rx_chan = dma_claim_unused_channel(true);
+    rx_cfg = dma_channel_get_default_config(rx_chan);
+    channel_config_set_transfer_data_size(&rx_cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&rx_cfg, false);
+    channel_config_set_write_increment(&rx_cfg, true);
+    channel_config_set_dreq(&rx_cfg, i2c_get_dreq(bus, false));
+
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS | I2C_IC_DMA_CR_RDMAE_BITS;
+    (void)hw->clr_intr;
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+
+    uint irq = I2C0_IRQ + i2c_hw_index(bus);
+    irq_set_exclusive_handler(irq, i2c_bus_irq);
+    irq_set_enabled(irq, true);
+}
+
+// Coloca a transação na fila; false se ela ainda estiver pendente
+bool i2c_bus_submit(i2c_txn_t *txn) {
+    if (txn->busy) return false;
+    txn->busy = true;
+    txn->next = NULL;
+    txn->queued_us = time_us_32();
+
+    uint32_t irq = save_and_disable_interrupts();
+    uint8_t p = txn->prio < I2C_PRIO_COUNT ? txn->prio : I2C_PRIO_LOW;
+    if (queue_tail[p]) queue_tail[p]->next = txn;
+    else queue_head[p] = txn;
+    queue_tail[p] = txn;
+    if (!current) start_next();
+    restore_interrupts(irq);
+    return true;
+}
+
+// Para inicialização e comandos avulsos: não usar dentro de interrupções
+bool i2c_bus_transfer_blocking(i2c_txn_t *txn) {
+    if (!i2c_bus_submit(txn)) return false;
+    while (txn->busy) tight_loop_contents();
+    return txn->ok;
+}
+
+bool i2c_bus_idle(void) {
+    return current == NULL;
+}
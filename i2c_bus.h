@@ -0,0 +1,74 @@
+/**
+ * Gerenciador do barramento I2C (i2c_default)
+ *
+ * Todos os dispositivos do barramento (display, ADC externo) enviam
+ * transações para uma fila com duas prioridades. Cada transação é
+ * transferida por DMA e termina na interrupção de STOP do I2C, que chama o
+ * callback da transação e inicia a próxima. Leituras de sensores (prioridade
+ * alta) passam à frente das partes do display que ainda estão na fila, então
+ * esperam no máximo uma página do display e não o quadro inteiro.
+ *
+ * As transações pertencem a quem as envia (sem alocação) e não podem ser
+ * alteradas enquanto busy for true.
+ */
+
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/i2c.h"
+
+#define I2C_BUS_MAX_LEN 136     // Bytes por transação (prefixo + escrita + leitura)
+
+typedef enum {
+    I2C_PRIO_HIGH,              // Leituras de sensores
+    I2C_PRIO_LOW,               // Display
+    I2C_PRIO_COUNT
+} i2c_prio_t;
+
+// Dispositivos com estatísticas próprias (tela de barramento)
+typedef enum {
+    I2C_DEV_DISPLAY,
+    I2C_DEV_SENSOR,
+    I2C_DEV_COUNT
+} i2c_dev_t;
+
+typedef struct {
+    uint32_t txns;              // Transações concluídas
+    uint32_t errors;            // Transações sem ACK
+    uint32_t lat_max_us;        // Maior tempo da fila até o STOP
+    uint32_t lat_avg_us;        // Média exponencial (1/16) do mesmo tempo
+    uint32_t wait_max_us;       // Maior espera na fila antes de começar
+} i2c_dev_stats_t;
+
+typedef struct i2c_txn i2c_txn_t;
+typedef void (*i2c_done_cb_t)(i2c_txn_t *txn, bool ok);
+
+struct i2c_txn {
+    uint8_t addr;               // Endereço de 7 bits
+    uint8_t prio;               // i2c_prio_t
+    uint8_t dev;                // i2c_dev_t
+    int16_t prefix;             // Byte escrito antes de tx (-1 = nenhum)
+    const uint8_t *tx;          // Bytes escritos
+    uint16_t tx_len;
+    uint8_t *rx;                // Bytes lidos após a escrita (com RESTART)
+    uint16_t rx_len;
+    i2c_done_cb_t done;         // Chamado na interrupção ao terminar (pode ser NULL)
+    void *user;
+
+    // Estado interno
+    volatile bool busy;         // Na fila ou em andamento
+    bool ok;                    // Resultado da última execução
+    uint32_t queued_us;
+    i2c_txn_t *next;
+};
+
+extern i2c_dev_stats_t i2c_bus_stats[I2C_DEV_COUNT];
+
+void i2c_bus_init(i2c_inst_t *i2c);
+bool i2c_bus_submit(i2c_txn_t *txn);
+bool i2c_bus_transfer_blocking(i2c_txn_t *txn);
+bool i2c_bus_idle(void);
+
+#endif
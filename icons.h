@@ -0,0 +1,19 @@
+/**
+ * Ícones 8x8 da tela de status, no formato de páginas do SSD1306
+ * (um byte por coluna, bit 0 = linha de cima).
+ */
+
+#ifndef ICONS_H
+#define ICONS_H
+
+#include "blit.h"
+
+static const uint8_t icon_thermometer_data[] = { 0x00, 0x60, 0xfe, 0xf9, 0xf9, 0xfe, 0x60, 0x00 };
+static const uint8_t icon_alarm_data[]       = { 0x20, 0x3c, 0x3e, 0xbf, 0xbf, 0x3e, 0x3c, 0x20 };
+static const uint8_t icon_battery_data[]     = { 0x7e, 0x42, 0x42, 0x42, 0x42, 0x42, 0x7e, 0x3c };
+
+static const bitmap_t icon_thermometer = { icon_thermometer_data, 8, 8, false };
+static const bitmap_t icon_alarm       = { icon_alarm_data, 8, 8, false };
+static const bitmap_t icon_battery     = { icon_battery_data, 8, 8, false };
+
+#endif
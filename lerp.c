@@ -0,0 +1,70 @@
+/**
+ * Interpolação em ponto fixo pelo interpolador do SIO (interp0)
+ */
+
+#include "pico/stdlib.h"
+#include "lerp.h"
+
+#if PICO_ON_DEVICE
+#include "hardware/interp.h"
+#endif
+
+int32_t lerp_lut16_sw(const int16_t *lut, uint32_t code16) {
+    if (code16 > 0xFFFF) code16 = 0xFFFF;
+    const int16_t *p = &lut[code16 >> 8];
+    return p[0] + (((p[1] - p[0]) * (int32_t)(code16 & 0xFF)) >> 8);
+}
+
+int32_t lerp_blend_sw(int32_t a, int32_t b, uint8_t alpha) {
+    return a + (((b - a) * alpha) >> 8);
+}
+
+#if PICO_ON_DEVICE
+
+void lerp_init(void) {
+    // Pista 0: (código >> 7) & 0x1FE = índice * 2 bytes; FULL = BASE2 + isso
+    interp_config cfg = interp_default_config();
+    interp_config_set_blend(&cfg, true);
+    interp_config_set_shift(&cfg, 7);
+    interp_config_set_mask(&cfg, 1, 8);
+    interp_set_config(interp0, 0, &cfg);
+
+    // Pista 1: fração nos 8 bits baixos, mistura com sinal
+    cfg = interp_default_config();
+    interp_config_set_signed(&cfg, true);
+    interp_config_set_mask(&cfg, 0, 7);
+    interp_set_config(interp0, 1, &cfg);
+}
+
+int32_t lerp_lut16(const int16_t *lut, uint32_t code16) {
+    if (code16 > 0xFFFF) code16 = 0xFFFF;
+    interp0->accum[0] = code16;
+    interp0->accum[1] = code16;
+    interp0->base[2] = (uintptr_t)lut;
+    const int16_t *p = (const int16_t *)(uintptr_t)interp0->peek[2];
+    interp0->base[0] = p[0];
+    interp0->base[1] = p[1];
+    return (int32_t)interp0->peek[1];
+}
+
+int32_t lerp_blend(int32_t a, int32_t b, uint8_t alpha) {
+    interp0->accum[1] = alpha;
+    interp0->base[0] = a;
+    interp0->base[1] = b;
+    return (int32_t)interp0->peek[1];
+}
+
+#else
+
+void lerp_init(void) {
+}
+
+int32_t lerp_lut16(const int16_t *lut, uint32_t code16) {
+    return lerp_lut16_sw(lut, code16);
+}
+
+int32_t lerp_blend(int32_t a, int32_t b, uint8_t alpha) {
+    return lerp_blend_sw(a, b, alpha);
+}
+
+#endif
@@ -0,0 +1,33 @@
+/**
+ * Interpolação em ponto fixo pelo interpolador do SIO (interp0)
+ *
+ * O interp0 fica configurado uma vez em modo blend: a pista 0 monta o
+ * endereço da tabela (shift/mask do código + BASE2) e a pista 1 separa a
+ * fração de 8 bits e faz a mistura com sinal entre BASE0 e BASE1. Assim a
+ * busca na tabela do NTC e a média exponencial do VSYS custam poucas
+ * escritas e leituras de registrador.
+ *
+ * O interp0 pertence ao caminho de amostragem (callback do timer); outro
+ * uso precisa salvar e restaurar o estado (interp_save/interp_restore).
+ * Sem o hardware (PICO_ON_DEVICE = 0) as mesmas funções são feitas em C.
+ */
+
+#ifndef LERP_H
+#define LERP_H
+
+#include <stdint.h>
+
+void lerp_init(void);
+
+// Tabela de 257 pontos indexada pelos 8 bits altos de um código de 16 bits,
+// interpolada linearmente pelos 8 bits baixos
+int32_t lerp_lut16(const int16_t *lut, uint32_t code16);
+
+// a + (b - a) * alpha / 256
+int32_t lerp_blend(int32_t a, int32_t b, uint8_t alpha);
+
+// Versões em software (fallback e referência do benchmark)
+int32_t lerp_lut16_sw(const int16_t *lut, uint32_t code16);
+int32_t lerp_blend_sw(int32_t a, int32_t b, uint8_t alpha);
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * Recepção e despacho dos quadros de comando da USB
+ */
+
+#include "pico/stdlib.h"
+#include "link.h"
+#include "crc.h"
+#include "ota.h"
+#include "control.h"
+
+static uint8_t rx[LINK_PAYLOAD_MAX + 2 + 2];    // Quadro recebido (COBS, com o CRC)
+static uint16_t rx_len = 0;
+
+// Decodifica o quadro COBS recebido, confere o CRC-16 e entrega ao destino
+static void receive_frame(void) {
+    uint32_t in = 0, out = 0;
+    while (in < rx_len) {
+        uint8_t code = rx[in++];
+        if (code == 0 || in + code - 1 > rx_len) return;
+        for (uint8_t i = 1; i < code; i++) rx[out++] = rx[in++];
+        if (code < 0xFF && in < rx_len) rx[out++] = 0;
+    }
+    if (out < 3) return;
+    uint16_t crc = rx[out - 2] | rx[out - 1] << 8;
+    if (crc16_copy(NULL, rx, out - 2, CRC16_INIT) != crc) return;  // O computador repete
+
+    switch (rx[0]) {
+        case 'B':
+        case 'D':
+        case 'E':
+        case 'A':
+            ota_frame(rx, out - 2);
+            break;
+        case 'K':
+            control_frame(rx, out - 2);
+            break;
+    }
+}
+
+void link_poll(void) {
+    int c;
+    while (!ota_busy() && (c = getchar_timeout_us(0)) >= 0) {
+        // Com um quadro de dados da atualização pendente, o próximo só é
+        // lido depois da confirmação (o resto fica no buffer da USB)
+        if (c == 0) {
+            receive_frame();
+            rx_len = 0;
+        } else if (rx_len < sizeof(rx)) {
+            rx[rx_len++] = c;
+        } else {
+            rx_len = sizeof(rx);    // Grande demais: descartado no próximo 0x00
+        }
+    }
+}
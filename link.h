@@ -0,0 +1,22 @@
+/**
+ * Quadros de comando recebidos pela serial da USB
+ *
+ * O computador envia quadros COBS com CRC-16 (CCITT-FALSE) no fim,
+ * terminados em 0x00; o primeiro byte diz o destino:
+ *   'B', 'D', 'E', 'A'  atualização do firmware (ota.c)
+ *   'K'                 ajuste do controle do soprador (control.c)
+ * Quadros com CRC errado são descartados em silêncio (o computador repete
+ * quando a resposta não chega). As respostas saem pelo log binário.
+ */
+
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdint.h>
+#include "ota.h"
+
+#define LINK_PAYLOAD_MAX    (1 + 2 + OTA_CHUNK_MAX)     // Maior quadro ('D'), sem o CRC
+
+void link_poll(void);   // Loop principal: lê a USB sem bloquear e despacha os quadros
+
+#endif
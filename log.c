@@ -0,0 +1,82 @@
+/**
+ * Log binário com formatação adiada (buffer circular e envio em COBS)
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "log.h"
+#include "crc.h"
+#include "ring.h"
+
+// Registro: [id | nargs << 16 | seq << 24] [instante em µs] [argumentos...]
+#define LOG_HEADER_WORDS 2
+#define LOG_FRAME_BYTES ((LOG_HEADER_WORDS + LOG_MAX_ARGS) * 4 + 2)  // + CRC-16
+
+log_stats_t log_stats;
+
+RING_DEFINE(log_ring, uint32_t, LOG_RING_WORDS)
+
+static log_ring_t ring;         // Vários produtores, consumido pelo loop principal
+static uint8_t seq = 0;
+
+// Chamada pelo LOG(), de qualquer contexto. O M0+ não tem LDREX/STREX:
+// o registro inteiro é gravado com as interrupções desligadas, o que dura
+// menos que reservar o espaço e confirmar depois. O head só avança com o
+// registro completo, então o loop principal nunca lê um pela metade.
+void log_write(uint32_t id, const uint32_t *args, uint32_t nargs) {
+    uint32_t rec[LOG_HEADER_WORDS + LOG_MAX_ARGS];
+    for (uint32_t i = 0; i < nargs; i++) rec[LOG_HEADER_WORDS + i] = args[i];
+    uint32_t irq = save_and_disable_interrupts();
+    rec[0] = (id & 0xFFFF) | nargs << 16 | (uint32_t)seq++ << 24;
+    rec[1] = time_us_32();
+    if (!log_ring_push_n(&ring, rec, LOG_HEADER_WORDS + nargs)) {
+        // Buffer cheio: a sequência avança e o computador vê o buraco
+        log_stats.dropped++;
+    } else {
+        log_stats.records++;
+    }
+    restore_interrupts(irq);
+}
+
+// Envia um registro em COBS (nenhum 0x00 dentro do quadro) seguido de 0x00
+static void send_frame(const uint8_t *data, uint32_t len) {
+    uint8_t out[LOG_FRAME_BYTES + 2];
+    uint32_t code_pos = 0, n = 1;
+    uint8_t code = 1;
+    for (uint32_t i = 0; i < len; i++) {
+        if (data[i] == 0) {
+            out[code_pos] = code;
+            code_pos = n++;
+            code = 1;
+        } else {
+            out[n++] = data[i];
+            code++;
+        }
+    }
+    out[code_pos] = code;
+    for (uint32_t i = 0; i < n; i++) putchar_raw(out[i]);
+    putchar_raw(0);
+}
+
+// Esvazia o buffer pela serial (loop principal, fora das interrupções).
+// O registro é copiado para o quadro pelo DMA, que calcula o CRC-16 no
+// caminho (em dois trechos quando ele dá a volta no buffer)
+void log_flush(void) {
+    uint8_t frame[LOG_FRAME_BYTES];
+    uint32_t *p;
+    uint32_t first;
+    while ((first = log_ring_read_span(&ring, &p))) {
+        uint32_t len = LOG_HEADER_WORDS + (p[0] >> 16 & 0xFF);
+        if (first > len) first = len;
+        uint16_t crc = crc16_copy(frame, p, first * 4, CRC16_INIT);
+        log_ring_consume(&ring, first);     // Libera o espaço antes do envio
+        if (first < len) {
+            log_ring_read_span(&ring, &p);  // Resto do registro, no início
+            crc = crc16_copy(&frame[first * 4], p, (len - first) * 4, crc);
+            log_ring_consume(&ring, len - first);
+        }
+        frame[len * 4] = crc & 0xFF;
+        frame[len * 4 + 1] = crc >> 8;
+        send_frame(frame, len * 4 + 2);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * Log binário com formatação adiada (no estilo do defmt)
+ *
+ * LOG("t=%.2f codigo=%u", temp, code) não formata nada no firmware: grava
+ * num buffer circular só o endereço da string de formato, uma sequência,
+ * o instante (µs) e os argumentos como palavras de 32 bits. As strings ficam
+ * na seção .log_fmt, que vai para o ELF mas não é carregada (não ocupa
+ * flash); o endereço dela é a identificação da mensagem. O loop principal
+ * esvazia o buffer pela serial em quadros COBS terminados em 0x00, com um
+ * CRC-16 calculado pelo sniffer do DMA na cópia do registro, e
+ * tools/log_decode.py remonta o texto com o ELF do mesmo build.
+ *
+ * Argumentos (até LOG_MAX_ARGS): inteiros, float/double (enviados como
+ * float) e strings constantes (%s: só o ponteiro, lido do ELF no
+ * computador; não use com buffers em RAM). Pode ser chamado de interrupções:
+ * a gravação de um registro custa algumas dezenas de ciclos.
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define LOG_RING_WORDS  512     // Buffer em palavras (potência de 2, 2 kB)
+#define LOG_MAX_ARGS    8
+
+typedef struct {
+    uint32_t records;           // Registros gravados
+    uint32_t dropped;           // Registros perdidos com o buffer cheio
+} log_stats_t;
+
+extern log_stats_t log_stats;
+
+void log_write(uint32_t id, const uint32_t *args, uint32_t nargs);
+void log_flush(void);           // Envia os registros pendentes (loop principal)
+
+// Seção sem o flag de alocação: o '@' comenta os flags que o compilador
+// acrescentaria na diretiva .section do montador ARM
+#if PICO_ON_DEVICE
+#define LOG_SECTION __attribute__((section(".log_fmt,\"\",%progbits @")))
+#else
+#define LOG_SECTION __attribute__((section(".log_fmt")))
+#endif
+
+static inline uint32_t log_u32(uint32_t x) { return x; }
+static inline uint32_t log_i32(int32_t x) { return (uint32_t)x; }
+static inline uint32_t log_ptr(const void *p) { return (uint32_t)(uintptr_t)p; }
+static inline uint32_t log_f32(float f) {
+    uint32_t w;
+    memcpy(&w, &f, sizeof w);
+    return w;
+}
+static inline uint32_t log_f64(double d) { return log_f32((float)d); }
+
+#define LOG_WORD(x) _Generic((x),                       \
+        float: log_f32, double: log_f64,                \
+        char *: log_ptr, const char *: log_ptr,         \
+        int: log_i32, long: log_i32, short: log_i32,    \
+        default: log_u32)(x)
+
+// Contagem e conversão dos argumentos (0 a LOG_MAX_ARGS)
+#define LOG_NARGS(...) LOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define LOG_CAT(a, b) LOG_CAT_(a, b)
+#define LOG_CAT_(a, b) a##b
+#define LOG_W0()
+#define LOG_W1(a) , LOG_WORD(a)
+#define LOG_W2(a, ...) , LOG_WORD(a) LOG_W1(__VA_ARGS__)
+#define LOG_W3(a, ...) , LOG_WORD(a) LOG_W2(__VA_ARGS__)
+#define LOG_W4(a, ...) , LOG_WORD(a) LOG_W3(__VA_ARGS__)
+#define LOG_W5(a, ...) , LOG_WORD(a) LOG_W4(__VA_ARGS__)
+#define LOG_W6(a, ...) , LOG_WORD(a) LOG_W5(__VA_ARGS__)
+#define LOG_W7(a, ...) , LOG_WORD(a) LOG_W6(__VA_ARGS__)
+#define LOG_W8(a, ...) , LOG_WORD(a) LOG_W7(__VA_ARGS__)
+
+#define LOG(fmt, ...) do {                                                  \
+    static const char log_fmt_[] LOG_SECTION = fmt;                         \
+    const uint32_t log_args_[] = { 0 LOG_CAT(LOG_W, LOG_NARGS(__VA_ARGS__))(__VA_ARGS__) }; \
+    log_write(log_ptr(log_fmt_), log_args_ + 1, LOG_NARGS(__VA_ARGS__));    \
+} while (0)
+
+#endif
@@ -7,6 +7,7 @@
  * - Exibição em display OLED 128x32
  * - Troca de unidade (Celsius/Fahrenheit) por botão
  * - LED indicador para temperatura abaixo de 40°C
+ * - Monitoramento da bateria (VSYS) com modo de economia
  * - Eficiência energética com modo sleep
  */
 
@@ -17,232 +18,352 @@
 #include <string.h>      // Manipulação de strings
 #include <stdlib.h>      
 #include <ctype.h>       // Manipulação de caracteres
+#include <math.h>        // sqrtf (ruído dos blocos)
 #include "pico/stdlib.h" // SDK do Raspberry Pi Pico
 #include "pico/binary_info.h" // Metadados para ferramentas
 #include "hardware/i2c.h"     // Comunicação I2C
 #include "hardware/adc.h"     // Conversor Analógico-Digital
 #include "hardware/gpio.h"    // Controle de GPIO
+#include "hardware/pwm.h"     // Brilho do LED
 #include "hardware/sync.h"    // Funções de sincronização (inclui __wfi)
-#include "ssd1306_font.h"     // Fonte para o display OLED
+#include "i2c_bus.h"          // Fila de transações do I2C
+#include "ssd1306.h"          // Driver do display OLED
+#include "blit.h"             // Desenho de bitmaps no framebuffer
+#include "screens.h"          // Gerenciador de telas
+#include "alarms.h"           // Alarmes ativos
+#include "history.h"          // Mínimo/máximo e tendência
+#include "predict.h"          // Previsão do tempo até 55°C / 40°C
+#include "phase.h"            // Fase da compostagem (estado na flash)
+#include "supply.h"           // Monitoramento da alimentação (VSYS)
+#include "acq.h"              // Backends de aquisição do diodo
+#include "sensor.h"           // Conversão para temperatura (diodo ou NTC)
+#include "diag.h"             // Diagnóstico do sensor (aberto, curto, ruído, sem leitura)
+#include "filter.h"           // Média móvel ou filtro adaptativo ao ruído (-DFILTER_ADAPTIVE=ON)
+#include "lerp.h"             // Interpolador do SIO (tabelas e filtros)
+#include "log.h"              // Log binário (formatado no computador)
+#include "crc.h"              // CRC pelo sniffer do DMA (flash e log)
+#include "ota.h"              // Atualização do firmware pela USB
+#include "link.h"             // Quadros de comando pela USB (OTA e controle)
+#include "control.h"          // Controle do soprador (liga/desliga ou PID)
+#include "rate.h"             // Conversores de taxa entre os estágios
+#include "block.h"            // Blocos de amostras com contagem de referências
+#include "pool.h"             // Pools de blocos fixos (sem heap)
+#include "app.h"              // Estado compartilhado com as telas
+#include "raspberry26x32.h"   // Logo da tela de abertura
+#include "bench.h"            // Benchmarks (somente com -DBENCHMARK=ON)
 
 
 /* 2. DEFINIÇÕES E CONSTANTES */
 
-// Configurações do display OLED (dadas pelo próprio exemplo da Adafruit)
-#define SSD1306_HEIGHT      32      // Altura do display em pixels
-#define SSD1306_WIDTH       128     // Largura do display em pixels
-#define SSD1306_I2C_ADDR    _u(0x3C) // Endereço I2C do display
-#define SSD1306_I2C_CLK     400     // Clock I2C em kHz (padrão)
-#define SSD1306_PAGE_HEIGHT _u(8)   // Altura de uma página (padrão)
-#define SSD1306_NUM_PAGES   (SSD1306_HEIGHT / SSD1306_PAGE_HEIGHT)
-#define SSD1306_BUF_LEN     (SSD1306_NUM_PAGES * SSD1306_WIDTH)
-
-// Configurações do ADC
-#define ADC_PIN     26      // GPIO 26 (Canal ADC0)
-#define ADC_NUM     0       // Número do canal ADC
-#define ADC_VREF    3.3f  // Tensão de referência medida 
-#define ADC_RANGE   (1 << 12) // Faixa do ADC (12 bits = 4096 valores)
+// Backend de aquisição do diodo (configurado no CMake: sar ou sdm)
+#ifndef ACQ_BACKEND
+#define ACQ_BACKEND acq_sar
+#endif
+
+// Filtro da temperatura: média móvel fixa ou adaptativa ao ruído (CMake)
+#ifndef FILTER_ADAPTIVE
+#define FILTER_ADAPTIVE 0
+#endif
+
+// Sensor ligado ao canal analógico (configurado no CMake: diode ou ntc)
+#ifndef SENSOR_TYPE
+#define SENSOR_TYPE sensor_diode
+#endif
 
 // Pinos GPIO
 #define LED_PIN     11      // GPIO para o LED indicador
-#define BUTTON_PIN  10      // GPIO para o botão de troca de unidade
-
-// Configurações da média móvel
-#define MOVING_AVG_SIZE 40  // Tamanho da janela para média móvel
+#define BUTTON_PIN  10      // GPIO para o botão (telas e unidade)
+
+// Gestos do botão
+#define BUTTON_DEBOUNCE_MS  50  // Tempo de acomodação após cada borda
+#define BUTTON_LONG_MS      800 // Pressão longa: troca a unidade
+#define SCREEN_ROTATE_MS    15000 // Rotação automática das telas (0 = desligada)
+#define SCREEN_IDLE_MS      60000 // Pausa da rotação após uso do botão
+
+// Taxas do pipeline: cada estágio tem o seu período e é ligado ao anterior
+// por um decimador (média no período) ou pela retenção do último valor
+// (rate.h), então a amostragem pode ficar mais rápida sem mudar a tela, o
+// log e os consumidores da temperatura filtrada
+#define SAMPLE_MS           500   // Aquisição e filtro (a janela da média móvel é em amostras)
+#define SAMPLE_LOW_MS       2000  // Aquisição com bateria fraca
+#define OUTPUT_MS           500   // Saída do filtro: LED, histórico, previsão, fase e controle
+#define DISPLAY_MS          1000  // Redesenho da tela (dados novos retidos até lá)
+#define DISPLAY_LOW_MS      10000 // Redesenho com bateria fraca
+#define LOG_MS              60000 // Registro das amostras no log binário (média, mínimo e máximo)
+#define TELEMETRY_MS        10000 // Linhas de telemetria (serial)
+#define SENSOR_LOG_MS       60000 // Lembrete no log de uma falha do sensor mantida
+
+// LED e alarme de temperatura baixa: acende abaixo de TEMP_LOW_C e só apaga
+// acima de TEMP_LOW_C + TEMP_LOW_HYST_C (o ruído não faz o alarme piscar)
+#define TEMP_LOW_C          40.0f
+#define TEMP_LOW_HYST_C     0.5f
+
+// Modo de bateria fraca
+#define DISPLAY_LOW_CONTRAST 0x10 // Contraste do display com bateria fraca
+#define LED_PWM_WRAP        999   // Resolução do PWM do LED
+#define LED_LOW_DUTY        100   // Brilho do LED com bateria fraca (10%)
 
 
 /* 3. VARIÁVEIS GLOBAIS */
 
-// Histórico para média móvel
-float temp_history[MOVING_AVG_SIZE];   // Buffer circular de temperaturas
-int history_index = 0;                 // Índice atual no buffer
-bool history_filled = false;           // Flag indicando buffer cheio
-
 // Controle do sistema
-volatile bool button_pressed = false;  // Flag para botão pressionado
+typedef enum { BUTTON_NONE, BUTTON_SHORT, BUTTON_LONG } button_event_t;
+volatile button_event_t button_event = BUTTON_NONE; // Último gesto do botão
+bool button_down = false;              // Botão pressionado (visto pela ISR)
+bool button_long_fired = false;        // Pressão longa já sinalizada
+alarm_id_t button_long_alarm = 0;      // Alarme que detecta a pressão longa
 bool show_fahrenheit = false;          // Unidade de exibição (false=Celsius)
-bool update_display = false;           // Flag para atualizar display
+bool temp_low = false;                 // Alarme de temperatura baixa ativo
 float raw_temp = 0.0f;                 // Temperatura bruta (Celsius)
 float filtered_temp = 0.0f;            // Temperatura filtrada (Celsius)
 float voltage = 0.0f;                  // Tensão lida do ADC
+uint32_t adc_raw = 0;                  // Último código bruto do conversor
+const acq_backend_t *acq = &ACQ_BACKEND; // Backend de aquisição em uso
+const sensor_type_t *sensor = &SENSOR_TYPE; // Tipo do sensor analógico
+acq_sample_t last_sample;              // Última leitura do backend
+float sensor_celsius = 0.0f;           // Temperatura das sondas digitais
+bool sensor_valid = false;             // Backend já entregou alguma leitura
+uint32_t sample_count = 0;             // Amostras lidas desde o boot
+rate_dec_t output_dec = RATE_DEC(OUTPUT_MS); // Filtro -> consumidores
+rate_dec_t log_raw_dec = RATE_DEC(LOG_MS);   // Bruta -> log binário
+rate_dec_t log_filt_dec = RATE_DEC(LOG_MS);  // Filtrada -> log binário
+block_t *acq_block = NULL;             // Bloco de amostras brutas em preenchimento
+block_queue_t log_blocks;              // Blocos para o log (loop principal)
+block_queue_t tel_blocks;              // Blocos para a telemetria
+block_queue_t *const block_consumers[] = { &log_blocks, &tel_blocks };
+
+
+/* 4. FUNÇÕES DO DISPLAY OLED */
+// Driver em ssd1306.c e desenho de bitmaps em blit.c
+
+// Tela de abertura com o logo da Raspberry Pi
+void show_splash(struct render_area *area) {
+    uint8_t buf[SSD1306_BUF_LEN];
+    memset(buf, 0, SSD1306_BUF_LEN);
+
+    bitmap_t logo = { raspberry26x32, IMG_WIDTH, IMG_HEIGHT, false };
+    blit(buf, 0, 0, &logo, BLIT_COPY);
+    WriteString(buf, 34, 8, "COMPOSTEIRA");
+    WriteString(buf, 34, 16, "INICIANDO");
+
+    render(buf, area);
+}
 
 
-/* 4. ESTRUTURAS DE DADOS */
-
-// Área de renderização para o display OLED (dado pelo próprio exemplo da Adafruit)
-struct render_area {
-    uint8_t start_col;  
-    uint8_t end_col;    
-    uint8_t start_page;
-    uint8_t end_page;
-    int buflen;
-};
-
-
-/* 5. FUNÇÕES DO DISPLAY OLED */ 
-// Dadas pelo próprio exemplo da Adafruit
+/* 5. FUNÇÕES DE PROCESSAMENTO */
 
-void calc_render_area_buflen(struct render_area *area) {
-    area->buflen = (area->end_col - area->start_col + 1) * (area->end_page - area->start_page + 1);
-}
 
-void SSD1306_send_cmd(uint8_t cmd) {
-    uint8_t buf[2] = {0x80, cmd};
-    i2c_write_blocking(i2c_default, SSD1306_I2C_ADDR, buf, 2, false);
-}
-
-void SSD1306_send_cmd_list(uint8_t *buf, int num) {
-    for (int i=0; i<num; i++)
-        SSD1306_send_cmd(buf[i]);
+// Lê a tensão do diodo pelo backend de aquisição e o VSYS pelo ADC. O
+// round-robin do ADC alterna entre os canais do backend e o VSYS (ADC3):
+// depois da leitura do backend, a próxima conversão é a alimentação
+float read_adc_voltage(uint32_t period_ms) {
+    acq_sample_t sample;
+    if (acq->read(&sample)) {
+        adc_raw = sample.code; // Guardado para a tela de diagnóstico
+        // Amostras do sensor aberto, em curto, travado ou fora da faixa não são usadas
+        bool ok = acq->celsius ? diag_check_celsius(sample.celsius) : diag_check(sample.code, acq->bits);
+        if (ok) {
+            last_sample = sample;
+            voltage = sample.voltage;
+            sensor_celsius = sample.celsius;
+            sensor_valid = true;
+        }
+    } else {
+        // Alguns períodos sem leitura, ou falha do backend: a medida anterior deixa de valer
+        diag_no_data(acq->fault && acq->fault());
+    }
+    uint16_t raw_vsys = adc_read(); // Canal seguinte do round-robin (VSYS/3)
+    supply_update((raw_vsys * ADC_VREF) / ADC_RANGE, period_ms);
+    return voltage; // Sem leitura nova, mantém a anterior
 }
 
-void SSD1306_send_buf(uint8_t buf[], int buflen) {
-    uint8_t *temp_buf = malloc(buflen + 1);
-    temp_buf[0] = 0x40;
-    memcpy(temp_buf+1, buf, buflen);
-    i2c_write_blocking(i2c_default, SSD1306_I2C_ADDR, temp_buf, buflen + 1, false);
-    free(temp_buf);
+// Registra no log as trocas de estado do sensor e, com a falha mantida, um
+// lembrete a cada SENSOR_LOG_MS: uma linha por amostra com o terminal aberto
+// a noite inteira encheria o buffer e empurraria os outros registros
+void log_sensor_state(uint32_t period_ms) {
+    static uint8_t logged = DIAG_OK;
+    static uint32_t elapsed_ms = 0;
+    uint8_t state = diag_fault() ? diag.fault : DIAG_OK;
+    elapsed_ms += period_ms;
+    if (state != logged || (state != DIAG_OK && elapsed_ms >= SENSOR_LOG_MS)) {
+        LOG("SENSOR %s codigo=%u", diag_name(state), adc_raw);
+        logged = state;
+        elapsed_ms = 0;
+    }
 }
 
-void SSD1306_init() {
-    uint8_t cmds[] = {
-        0xAE,       // SET_DISP: display off
-        0x20, 0x00, // SET_MEM_MODE: horizontal addressing
-        0x40,       // SET_DISP_START_LINE: start line 0
-        0xA1,       // SET_SEG_REMAP: column 127 mapped to SEG0
-        0xA8, 0x1F, // SET_MUX_RATIO: height-1 (31 for 32px display)
-        0xC8,       // SET_COM_OUT_DIR: scan from COM[N-1] to COM0
-        0xD3, 0x00, // SET_DISP_OFFSET: no offset
-        0xDA, 0x02, // SET_COM_PIN_CFG: sequential, disable COM left/right remap (32px height)
-        0xD5, 0x80, // SET_DISP_CLK_DIV: div ratio 1, standard freq
-        0xD9, 0xF1, // SET_PRECHARGE: Vcc internally generated
-        0xDB, 0x30, // SET_VCOM_DESEL: 0.83xVcc
-        0x81, 0xFF, // SET_CONTRAST: max contrast
-        0xA4,       // SET_ENTIRE_ON: output follows RAM content
-        0xA6,       // SET_NORM_DISP: normal display (not inverted)
-        0x8D, 0x14, // SET_CHARGE_PUMP: enable, Vcc internally generated
-        0xAF        // SET_DISP: display on
-    };
-
-    SSD1306_send_cmd_list(cmds, sizeof(cmds)/sizeof(cmds[0]));
+// Brilho do LED indicador (0 a LED_PWM_WRAP + 1)
+void led_set(bool on) {
+    pwm_set_gpio_level(LED_PIN, on ? (supply.low ? LED_LOW_DUTY : LED_PWM_WRAP + 1) : 0);
 }
 
-static inline int GetFontIndex(uint8_t ch) {
-    if (ch >= 'A' && ch <='Z') return ch - 'A' + 1;
-    else if (ch >= '0' && ch <='9') return ch - '0' + 27;
-    else return 0; // Space for unsupported characters
+// Conversão de Celcius para Fahrenheit
+float celsius_to_fahrenheit(float celsius) {
+    return (celsius * 9.0f / 5.0f) + 32.0f;
 }
 
-static void WriteChar(uint8_t *buf, int16_t x, int16_t y, uint8_t ch) {
-    if (x > SSD1306_WIDTH - 8 || y > SSD1306_HEIGHT - 8) return;
-    y = y/8;
-    ch = toupper(ch);
-    int idx = GetFontIndex(ch);
-    int fb_idx = y * 128 + x;
-    for (int i=0; i<8; i++) buf[fb_idx++] = font[idx * 8 + i];
+// Saídas decimadas vizinhas correlacionadas pelo filtro: a janela (em
+// amostras; a equivalente do adaptativo, que muda com o ruído) vista na
+// taxa da saída, que já é a média de out_ms / period_ms amostras
+float output_corr(uint32_t period_ms, uint32_t out_ms) {
+    uint32_t window = FILTER_ADAPTIVE ? filter_window() : MOVING_AVG_SIZE;
+    return (float)(window * period_ms + out_ms - period_ms) / out_ms;
 }
 
-static void WriteString(uint8_t *buf, int16_t x, int16_t y, char *str) {
-    if (x > SSD1306_WIDTH - 8 || y > SSD1306_HEIGHT - 8) return;
-    while (*str) WriteChar(buf, x, y, *str++), x+=8;
+// Consumidor do log: um registro por bloco, lido no lugar
+void log_block(const block_t *b) {
+    uint32_t lo = UINT32_MAX, hi = 0, sum = 0;
+    for (uint32_t i = 0; i < b->n; i++) {
+        uint32_t c = b->samples[i].code;
+        if (c < lo) lo = c;
+        if (c > hi) hi = c;
+        sum += c;
+    }
+    LOG("BLOCO seq=%u t0=%u n=%u codigo=%u..%u media=%.2f",
+        b->seq, b->t0_ms, b->n, lo, hi, (float)sum / b->n);
 }
 
-void render(uint8_t *buf, struct render_area *area) {
-    uint8_t cmds[] = {
-        0x21, area->start_col, area->end_col, // SET_COL_ADDR
-        0x22, area->start_page, area->end_page // SET_PAGE_ADDR
-    };
-    SSD1306_send_cmd_list(cmds, sizeof(cmds)/sizeof(cmds[0]));
-    SSD1306_send_buf(buf, area->buflen);
+// Desvio padrão da temperatura bruta no bloco (ruído, em °C)
+float block_noise(const block_t *b) {
+    float mean = 0.0f, m2 = 0.0f;
+    for (uint32_t i = 0; i < b->n; i++) {
+        float x = b->samples[i].centi * 0.01f, d = x - mean;
+        mean += d / (i + 1);
+        m2 += d * (x - mean);
+    }
+    return b->n > 1 ? sqrtf(m2 / (b->n - 1)) : 0.0f;
 }
 
 
-/* 6. FUNÇÕES DE PROCESSAMENTO */
-
+/* 6. INTERRUPÇÕES E CALLBACKS */
 
-// Lê o valor do ADC e converte para tensão
-float read_adc_voltage() {
-    uint16_t raw = adc_read(); // Lê valor bruto (0-4095)
-    return (raw * ADC_VREF) / ADC_RANGE; // Converte para tensão
-}
-
-// Conversão da tensão para temperatura em celcius
-float voltage_to_temperature(float voltage) {
-    return (voltage - 0.6264) / (-0.0021);
-}
+int64_t re_enable_button_irq(alarm_id_t id, void *user_data);
+int64_t button_long_press(alarm_id_t id, void *user_data);
 
-// Conversão de Celcius para Fahrenheit
-float celsius_to_fahrenheit(float celsius) {
-    return (celsius * 9.0f / 5.0f) + 32.0f;
-}
-
-// Calculadora da média móvel
-float moving_average(float new_temp) {
-    // 1. Armazena nova temperatura no buffer circular
-    temp_history[history_index] = new_temp;
-    
-    // 2. Atualiza índice (comportamento circular)
-    history_index = (history_index + 1) % MOVING_AVG_SIZE;
+// Interrupção e debounce do botão: distingue pressão curta (troca de tela)
+// de pressão longa (troca de unidade)
+void button_isr(uint gpio, uint32_t events) {
+    // 1. Desabilita temporariamente a interrupção para debounce
+    gpio_set_irq_enabled(BUTTON_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, false);
     
-    // 3. Marca quando o buffer está completamente preenchido
-    if (history_index == 0) {
-        history_filled = true;
+    // 2. Pressionou: agenda a detecção da pressão longa
+    if ((events & GPIO_IRQ_EDGE_FALL) && !button_down) {
+        button_down = true;
+        button_long_fired = false;
+        button_long_alarm = add_alarm_in_ms(BUTTON_LONG_MS, button_long_press, NULL, false);
     }
     
-    // 4. Calcula a média
-    float sum = 0;
-    int count = history_filled ? MOVING_AVG_SIZE : history_index;
-    
-    for (int i = 0; i < count; i++) {
-        sum += temp_history[i];
+    // 3. Soltou antes da pressão longa: pressão curta
+    if ((events & GPIO_IRQ_EDGE_RISE) && button_down) {
+        button_down = false;
+        cancel_alarm(button_long_alarm);
+        if (!button_long_fired) button_event = BUTTON_SHORT;
     }
     
-    return sum / count; // Retorna a média
+    // 4. Agenda reabilitação da interrupção (debounce)
+    add_alarm_in_ms(BUTTON_DEBOUNCE_MS, re_enable_button_irq, NULL, false);
 }
 
-
-/* 7. INTERRUPÇÕES E CALLBACKS */
-
-// Interrupção e debounce do botão
-void button_isr(uint gpio, uint32_t events) {
-    // 1. Desabilita temporariamente a interrupção para debounce
-    gpio_set_irq_enabled(BUTTON_PIN, GPIO_IRQ_EDGE_FALL, false);
-    
-    // 2. Marca que o botão foi pressionado
-    button_pressed = true;
-    
-    // 3. Agenda reabilitação da interrupção após 200ms (debounce)
-    add_alarm_in_ms(200, (alarm_callback_t)re_enable_button_irq, NULL, false);
+// Botão ainda pressionado após BUTTON_LONG_MS: pressão longa
+int64_t button_long_press(alarm_id_t id, void *user_data) {
+    if (button_down && !gpio_get(BUTTON_PIN)) {
+        button_long_fired = true;
+        button_event = BUTTON_LONG;
+    }
+    return 0; // Não repetir
 }
 
 // Libera a interrupção do botão pós debounce
-bool re_enable_button_irq(alarm_id_t id, void *user_data) {
-    gpio_set_irq_enabled(BUTTON_PIN, GPIO_IRQ_EDGE_FALL, true);
-    return false; // Não repetir
+int64_t re_enable_button_irq(alarm_id_t id, void *user_data) {
+    // Uma soltura dentro da janela de debounce não gerou interrupção
+    if (button_down && gpio_get(BUTTON_PIN)) {
+        button_down = false;
+        cancel_alarm(button_long_alarm);
+        if (!button_long_fired) button_event = BUTTON_SHORT;
+    }
+    gpio_set_irq_enabled(BUTTON_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    return 0; // Não repetir
 }
 
 // Leitura periódica do ADC (sensor) e controle de saídas (OLED e LED)
 bool adc_timer_callback(repeating_timer_t *rt) {
-    // 1. Lê tensão do ADC
-    voltage = read_adc_voltage();
-    
-    // 2. Converte tensão para temperatura (Celsius)
-    raw_temp = voltage_to_temperature(voltage);
-    
-    // 3. Calcula temperatura filtrada (média móvel)
-    filtered_temp = moving_average(raw_temp);
+    // 1. Lê tensão do ADC (e a alimentação, na mesma rodada)
+    uint32_t period_ms = supply.low ? SAMPLE_LOW_MS : SAMPLE_MS;
+    voltage = read_adc_voltage(period_ms);
+    log_sensor_state(period_ms);
+    if (diag_fault()) {
+        // Falha no sensor: LED piscando e a média móvel mantida como estava
+        static bool blink = false;
+        led_set(blink = !blink);
+        control_set_input(0, false); // Soprador desligado sem medida
+        screens_notify(DATA_TEMP | DATA_DIAG);
+        rt->delay_us = (int64_t)period_ms * 1000;
+        return true;
+    }
+    if (!sensor_valid) return true; // Sondas digitais ainda na 1ª conversão
     
-    // 4. Controle do LED (acende se temperatura < 40°C)
-    gpio_put(LED_PIN, filtered_temp < 40.0f);
+    // 2. Converte a leitura para temperatura (Celsius) pelo tipo do sensor;
+    // as sondas digitais já entregam °C
+    if (acq->celsius) raw_temp = sensor_celsius;
+    else raw_temp = sensor->to_celsius(&last_sample, acq);
     
-    // 5. Solicita atualização do display
-    update_display = true;
+    // 3. Calcula temperatura filtrada (média móvel ou média exponencial
+    // com a janela ajustada ao ruído medido)
+#if FILTER_ADAPTIVE
+    filtered_temp = filter_adaptive(raw_temp);
+#else
+    filtered_temp = filter_moving_average(raw_temp);
+#endif
+    sample_count++;
+
+    // 4. Bloco de amostras brutas: publicado cheio para o log e a
+    // telemetria, que o leem no lugar (sem cópia)
+    if (!acq_block) acq_block = block_alloc();
+    if (acq_block) {
+        if (acq_block->n == 0) acq_block->t0_ms = to_ms_since_boot(get_absolute_time());
+        acq_block->samples[acq_block->n++] = (block_sample_t){ adc_raw, (int16_t)(raw_temp * 100.0f) };
+        if (acq_block->n == BLOCK_SAMPLES) {
+            block_publish(acq_block, block_consumers, sizeof(block_consumers) / sizeof(block_consumers[0]));
+            acq_block = NULL;
+        }
+    }
+
+    // 5. Log binário na sua taxa: média, mínimo e máximo do período
+    rate_dec_add(&log_filt_dec, filtered_temp, period_ms);
+    if (rate_dec_add(&log_raw_dec, raw_temp, period_ms)) {
+        LOG("AMOSTRA n=%u codigo=%u bruta=%.3f min=%.3f max=%.3f filtrada=%.3f",
+            log_raw_dec.out_count, adc_raw, log_raw_dec.mean, log_raw_dec.lo,
+            log_raw_dec.hi, log_filt_dec.mean);
+    }
+
+    // 6. Saída do filtro na taxa dos consumidores (decimada)
+    if (rate_dec_add(&output_dec, filtered_temp, period_ms)) {
+        float out = output_dec.mean;
+        uint32_t out_ms = output_dec.out_ms;
+
+        // Controle do LED e alarme (temperatura < 40°C, com histerese)
+        if (out < TEMP_LOW_C) temp_low = true;
+        else if (out >= TEMP_LOW_C + TEMP_LOW_HYST_C) temp_low = false;
+        led_set(temp_low);
+        alarm_set(ALARM_TEMP_LOW, temp_low);
+
+        // Histórico, previsão, fase e controle; as telas são avisadas e
+        // redesenhadas na taxa delas (só a ativa)
+        history_add(out, out_ms);
+        predict_add(out, out_ms, output_corr(period_ms, out_ms));
+        phase_add(out, predict.valid ? predict.rate : 0.0f, out_ms);
+        control_set_input((int32_t)(out * 100.0f), true);
+        screens_notify(DATA_TEMP | DATA_DIAG | DATA_BUS);
+    }
+
+    // 7. Bateria fraca reduz a taxa de amostragem
+    rt->delay_us = (int64_t)(supply.low ? SAMPLE_LOW_MS : SAMPLE_MS) * 1000;
     
     return true; // Mantém o timer ativo
 }
 
 
-/* 8. FUNÇÃO PRINCIPAL */
+/* 7. FUNÇÃO PRINCIPAL */
 
 int main() {
     // Inicializa comunicação serial (para depuração)
@@ -254,7 +375,7 @@ int main() {
     puts("Default I2C pins were not defined");
 #else
 
-    /* 8.1 INICIALIZAÇÕES */
+    /* 7.1 INICIALIZAÇÕES */
     
     // Configura I2C
     bi_decl(bi_2pins_with_func(PICO_DEFAULT_I2C_SDA_PIN, PICO_DEFAULT_I2C_SCL_PIN, GPIO_FUNC_I2C));
@@ -263,23 +384,45 @@ int main() {
     gpio_set_function(PICO_DEFAULT_I2C_SCL_PIN, GPIO_FUNC_I2C); // Configura pino SCL
     gpio_pull_up(PICO_DEFAULT_I2C_SDA_PIN); // Habilita pull-up
     gpio_pull_up(PICO_DEFAULT_I2C_SCL_PIN); // Habilita pull-up
+    i2c_bus_init(i2c_default); // Fila de transações por DMA (display e sensores)
+
+    // Interpolador do caminho de amostragem (tabela do NTC e filtro do VSYS)
+    lerp_init();
+
+    // Canal de DMA do CRC (registros da flash e quadros do log)
+    crc_init();
+
+    // Pools de memória e blocos de amostras (spin locks de hardware)
+    pool_init();
+    block_init();
+
+    // Fase da compostagem e horas acima de 55°C gravadas antes do reset
+    phase_init();
 
     // Inicializa ADC
     adc_init(); // Habilita o bloco ADC
-    adc_gpio_init(ADC_PIN); // Configura GPIO26 como entrada analógica
-    adc_select_input(ADC_NUM); // Seleciona o canal ADC0
-
-    // Configura LED
-    gpio_init(LED_PIN); // Inicializa pino
-    gpio_set_dir(LED_PIN, GPIO_OUT); // Define como saída
-    gpio_put(LED_PIN, 0); // Inicia desligado
+    supply_init(); // Configura GPIO29 (VSYS/3) e GPIO24 (VBUS)
+    adc_select_input(VSYS_ADC_NUM);
+    acq->init(); // Backend do diodo (o SAR seleciona o ADC0)
+    adc_set_round_robin(acq->adc_channels | (1u << VSYS_ADC_NUM)); // Diodo e VSYS
+
+    // Configura LED (PWM para reduzir o brilho com bateria fraca)
+    gpio_set_function(LED_PIN, GPIO_FUNC_PWM);
+    pwm_config led_cfg = pwm_get_default_config();
+    pwm_config_set_wrap(&led_cfg, LED_PWM_WRAP);
+    pwm_init(pwm_gpio_to_slice_num(LED_PIN), &led_cfg, true);
+    led_set(false); // Inicia desligado
+
+    // Controle do soprador (alarme de hardware próprio, saída desligada
+    // até a primeira amostra)
+    control_init();
 
     // Configura Botão
     gpio_init(BUTTON_PIN); // Inicializa pino
     gpio_set_dir(BUTTON_PIN, GPIO_IN); // Define como entrada
     gpio_pull_up(BUTTON_PIN); // Habilita resistor de pull-up
-    // Configura interrupção para borda de descida (botão pressionado)
-    gpio_set_irq_enabled_with_callback(BUTTON_PIN, GPIO_IRQ_EDGE_FALL, true, &button_isr);
+    // Configura interrupção para as duas bordas (pressionado e solto)
+    gpio_set_irq_enabled_with_callback(BUTTON_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &button_isr);
 
     // Inicializa display OLED
     SSD1306_init();
@@ -291,55 +434,116 @@ int main() {
     };
     calc_render_area_buflen(&frame_area); // Calcula tamanho do buffer
 
+    // Tela de abertura e benchmarks (quando habilitados)
+    blit_dma_init();
+    show_splash(&frame_area);
+    bench_run();
+    sleep_ms(1500);
+
     // Configura timer para leitura periódica do ADC (500ms)
     repeating_timer_t adc_timer;
-    add_repeating_timer_ms(500, adc_timer_callback, NULL, &adc_timer);
+    add_repeating_timer_ms(SAMPLE_MS, adc_timer_callback, NULL, &adc_timer);
 
-    /* 8.2 LOOP PRINCIPAL */
+    /* 7.2 LOOP PRINCIPAL */
+
+    uint32_t last_rotate_ms = 0; // Última troca de tela (botão ou rotação)
+    rate_tick_t display_tick = RATE_TICK(DISPLAY_MS); // Redesenho da tela
+    rate_tick_t telemetry_tick = RATE_TICK(TELEMETRY_MS); // Linhas de telemetria
+    block_t *tel_block = NULL;   // Bloco retido pela telemetria
+    bool low_power = false;      // Modo de bateria fraca aplicado ao display
 
     while (1) {
-        // 1. Tratamento do botão
-        if (button_pressed) {
-            button_pressed = false;
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+
+        // 1. Tratamento do botão (lido e zerado de uma vez: um gesto que a
+        // interrupção ou o alarme do botão grave no meio não se perde)
+        uint32_t irq = save_and_disable_interrupts();
+        button_event_t event = button_event;
+        button_event = BUTTON_NONE;
+        restore_interrupts(irq);
+        if (event == BUTTON_SHORT) {
+            screens_next(); // Próxima tela
+            last_rotate_ms = now_ms + SCREEN_IDLE_MS;
+        } else if (event == BUTTON_LONG) {
             show_fahrenheit = !show_fahrenheit; // Alterna unidade
-            update_display = true; // Força atualização do display
+            screens_notify(DATA_UNIT);
+            last_rotate_ms = now_ms + SCREEN_IDLE_MS;
+        }
+
+        // 2. Rotação automática das telas
+        bool redraw_now = event != BUTTON_NONE;
+        if (SCREEN_ROTATE_MS && (int32_t)(now_ms - last_rotate_ms) >= SCREEN_ROTATE_MS) {
+            screens_next();
+            last_rotate_ms = now_ms;
+            redraw_now = true;
         }
 
-        // 2. Atualização do display quando necessário
-        if (update_display) {
-            update_display = false; // Reseta flag
-            
-            // Prepara buffer de exibição
-            uint8_t buf[SSD1306_BUF_LEN];
-            memset(buf, 0, SSD1306_BUF_LEN); // Limpa buffer
-            
-            // 2.1. Converte unidades se necessário
-            float display_temp = filtered_temp;
-            if (show_fahrenheit) {
-                display_temp = celsius_to_fahrenheit(display_temp);
+        // 3. Leituras adiadas do backend de aquisição (conversor externo)
+        if (acq->poll) acq->poll();
+
+        // 4. Estado da compostagem na flash (troca de fase ou periódico)
+        phase_poll();
+
+        // 5. Telemetria e log binário pela serial (o texto é montado no
+        // computador por tools/log_decode.py); os blocos de amostras são
+        // devolvidos ao pool pelo último consumidor
+        block_t *b;
+        while ((b = block_queue_pop(&log_blocks))) {
+            log_block(b);
+            block_release(b);
+        }
+        if (rate_tick_due(&telemetry_tick, now_ms)) {
+            irq = save_and_disable_interrupts();
+            predict_t p = predict; // Cópia consistente (o timer atualiza)
+            float temp = filtered_temp;
+            restore_interrupts(irq);
+            LOG("TEL t=%.2f taxa=%+.2f alvo=%.0f eta=%.2f ic=%.2f sensor=%s ruido=%.1f janela=%u",
+                temp, p.valid ? p.rate : 0.0f, p.target, p.eta_h, p.ci_h,
+                diag_name(diag.fault), diag_noise_lsb(),
+                FILTER_ADAPTIVE ? filter_window() : MOVING_AVG_SIZE);
+            uint32_t jitter_max = control_stats.jitter_max_us;
+            control_stats.jitter_max_us = 0;
+            LOG("CTL modo=%s saida=%u erro=%d jitter=%u max=%u",
+                control_mode_name(control_config.mode), control_stats.output,
+                control_stats.error, control_stats.jitter_us, jitter_max);
+
+            // A telemetria fica com o bloco mais recente até a próxima linha
+            while ((b = block_queue_pop(&tel_blocks))) {
+                if (tel_block) block_release(tel_block);
+                tel_block = b;
+            }
+            LOG("BLK seq=%d ruido=%.3f publicados=%u descartes=%u",
+                tel_block ? (int32_t)tel_block->seq : -1, tel_block ? block_noise(tel_block) : 0.0f,
+                block_stats.published, log_blocks.drops + tel_blocks.drops);
+            for (uint32_t id = 0; id < POOL_COUNT; id++) {
+                LOG("POOL %s uso=%u/%u max=%u falhas=%u", pool_name(id), pool_stats[id].in_use,
+                    pool_capacity(id), pool_stats[id].high_water, pool_stats[id].failures);
             }
-            
-            // 2.2. Formata strings
-            char voltage_str[16];
-            char temp_str[16];
-            sprintf(voltage_str, "%.3f V", voltage);
-            sprintf(temp_str, "%.1f %c", display_temp, show_fahrenheit ? 'F' : 'C');
-            
-            // 2.3. Escreve no buffer
-            WriteString(buf, 10, 0, "Tensao:");
-            WriteString(buf, 70, 0, voltage_str);
-            WriteString(buf, 10, 8, "Temp:");
-            WriteString(buf, 70, 8, temp_str);
-            
-            // 2.4. Atualiza display
-            render(buf, &frame_area);
+        }
+        log_flush();
+
+        // 6. Quadros da USB (tools/ota.py e tools/control.py) e montagem
+        // da imagem nova da atualização
+        link_poll();
+        ota_poll();
+
+        // 7. Bateria fraca: contraste reduzido e redesenho espaçado
+        if (supply.low != low_power) {
+            low_power = supply.low;
+            ssd1306_set_contrast(low_power ? DISPLAY_LOW_CONTRAST : 0xFF);
+            display_tick.period_ms = low_power ? DISPLAY_LOW_MS : DISPLAY_MS;
+        }
+
+        // 8. Atualiza a tela ativa na taxa da tela, se algum dado dela mudou
+        // (o botão e a rotação redesenham na hora, mesmo com bateria fraca)
+        if (rate_tick_due(&display_tick, now_ms) || redraw_now) {
+            screens_update();
         }
 
-        // 3. Entra em modo de baixo consumo (Wait For Interrupt)
-        __wfi(); // Reduz consumo enquanto aguarda eventos
+        // 9. Entra em modo de baixo consumo (Wait For Interrupt), a não ser
+        // que a montagem da imagem nova tenha páginas pendentes
+        if (!ota_busy()) __wfi(); // Reduz consumo enquanto aguarda eventos
     }
 #endif
     return 0;
 }
-
-//testando
\ No newline at end of file
@@ -0,0 +1,146 @@
+/**
+ * Mestre 1-Wire no PIO (onewire.pio)
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "onewire.h"
+#include "onewire.pio.h"
+
+#define OW_PIO  pio1    // pio0 fica com o conversor sigma-delta
+
+static int sm = -1;
+static int tx_chan = -1, rx_chan = -1;
+
+// Fim de transação: a interrupção só acorda o loop principal, que consulta ow_busy()
+static void ow_dma_irq(void) {
+    if (dma_channel_get_irq1_status(rx_chan)) dma_channel_acknowledge_irq1(rx_chan);
+}
+
+void ow_init(uint8_t pin) {
+    uint offset = pio_add_program(OW_PIO, &onewire_program);
+    sm = pio_claim_unused_sm(OW_PIO, true);
+    onewire_program_init(OW_PIO, sm, offset, pin);
+    tx_chan = dma_claim_unused_channel(true);
+    rx_chan = dma_claim_unused_channel(true);
+
+    dma_channel_set_irq1_enabled(rx_chan, true);
+    irq_add_shared_handler(DMA_IRQ_1, ow_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+void ow_begin(ow_txn_t *t, uint32_t *tx, uint32_t *rx, uint16_t cap) {
+    t->tx = tx;
+    t->rx = rx;
+    t->len = 0;
+    t->cap = cap;
+}
+
+static inline void add_slot(ow_txn_t *t, uint32_t word) {
+    if (t->len < t->cap) t->tx[t->len++] = word;
+}
+
+void ow_add_reset(ow_txn_t *t) {
+    add_slot(t, OW_SLOT_RESET);
+}
+
+// O 1-Wire transmite o bit menos significativo primeiro
+void ow_add_byte(ow_txn_t *t, uint8_t byte) {
+    for (int i = 0; i < 8; i++) add_slot(t, (byte >> i) & 1);
+}
+
+uint16_t ow_add_read(ow_txn_t *t, uint16_t nbytes) {
+    uint16_t first = t->len;
+    for (int i = 0; i < nbytes * 8; i++) add_slot(t, OW_SLOT_READ);
+    return first;
+}
+
+uint8_t ow_get_byte(const ow_txn_t *t, uint16_t slot) {
+    uint8_t byte = 0;
+    for (int i = 0; i < 8; i++) byte |= (t->rx[slot + i] >> 31) << i;
+    return byte;
+}
+
+bool ow_presence(const ow_txn_t *t, uint16_t slot) {
+    return (t->rx[slot] >> 31) == 0;
+}
+
+void ow_start(ow_txn_t *t) {
+    dma_channel_config c = dma_channel_get_default_config(rx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, pio_get_dreq(OW_PIO, sm, false));
+    dma_channel_configure(rx_chan, &c, t->rx, &OW_PIO->rxf[sm], t->len, true);
+
+    c = dma_channel_get_default_config(tx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(OW_PIO, sm, true));
+    dma_channel_configure(tx_chan, &c, &OW_PIO->txf[sm], t->tx, t->len, true);
+}
+
+// O último slot foi amostrado (a transação seguinte pode ser iniciada)
+bool ow_busy(void) {
+    return dma_channel_is_busy(rx_chan);
+}
+
+// Um slot trocado diretamente com o PIO (somente fora de transações)
+static uint32_t ow_slot(uint32_t word) {
+    pio_sm_put_blocking(OW_PIO, sm, word);
+    return pio_sm_get_blocking(OW_PIO, sm) >> 31;
+}
+
+// Busca de ROM (nota de aplicação 187 da Maxim): a cada bit os sensores
+// respondem o bit e o complemento; nas divergências segue o ramo 0 e, na
+// passagem seguinte, o ramo 1 da última divergência
+int ow_search(uint64_t *roms, int max) {
+    int found = 0;
+    int last_discrepancy = 0;
+    uint64_t rom = 0;
+
+    do {
+        if (ow_slot(OW_SLOT_RESET) != 0) break; // Sem presença
+        for (int i = 0; i < 8; i++) ow_slot((OW_SEARCH_ROM >> i) & 1);
+
+        int last_zero = 0;
+        for (int n = 1; n <= 64; n++) {
+            uint32_t bit = ow_slot(OW_SLOT_READ);
+            uint32_t cmp = ow_slot(OW_SLOT_READ);
+            if (bit && cmp) return found; // Nenhum sensor respondeu
+
+            uint32_t dir;
+            if (bit != cmp) dir = bit;
+            else {
+                dir = n < last_discrepancy ? (rom >> (n - 1)) & 1 : n == last_discrepancy;
+                if (!dir) last_zero = n;
+            }
+            if (dir) rom |= 1ull << (n - 1);
+            else rom &= ~(1ull << (n - 1));
+            ow_slot(dir);
+        }
+        last_discrepancy = last_zero;
+
+        uint8_t bytes[8];
+        for (int i = 0; i < 8; i++) bytes[i] = rom >> (8 * i);
+        if (ow_crc8(bytes, 8) == 0) roms[found++] = rom;
+    } while (last_discrepancy && found < max);
+
+    return found;
+}
+
+// CRC-8 do 1-Wire (x^8 + x^5 + x^4 + 1, refletido); 0 sobre dados + CRC
+uint8_t ow_crc8(const uint8_t *data, int len) {
+    uint8_t crc = 0;
+    while (len--) {
+        uint8_t b = *data++;
+        for (int i = 0; i < 8; i++, b >>= 1) {
+            crc = ((crc ^ b) & 1) ? (crc >> 1) ^ 0x8C : crc >> 1;
+        }
+    }
+    return crc;
+}
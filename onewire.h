@@ -0,0 +1,50 @@
+/**
+ * Mestre 1-Wire no PIO (onewire.pio)
+ *
+ * As transações são montadas como listas de slots (uma palavra por bit ou
+ * reset) e transferidas por DMA, sem a CPU nos tempos do barramento.
+ * A busca de ROM, feita só na inicialização, troca slot a slot com o PIO.
+ */
+
+#ifndef ONEWIRE_H
+#define ONEWIRE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define OW_SLOT_RESET   2u          // Palavra de reset (bit 1)
+#define OW_SLOT_READ    1u          // Leitura = escrita de um bit 1
+
+// Comandos de ROM
+#define OW_SEARCH_ROM   0xF0
+#define OW_MATCH_ROM    0x55
+#define OW_SKIP_ROM     0xCC
+
+// Transação em montagem: slots a enviar e níveis lidos de volta
+typedef struct {
+    uint32_t *tx;
+    uint32_t *rx;
+    uint16_t len;
+    uint16_t cap;
+} ow_txn_t;
+
+void ow_init(uint8_t pin);
+
+// Montagem da transação
+void ow_begin(ow_txn_t *t, uint32_t *tx, uint32_t *rx, uint16_t cap);
+void ow_add_reset(ow_txn_t *t);
+void ow_add_byte(ow_txn_t *t, uint8_t byte);
+uint16_t ow_add_read(ow_txn_t *t, uint16_t nbytes);    // Retorna o índice do 1º slot
+uint8_t ow_get_byte(const ow_txn_t *t, uint16_t slot);
+bool ow_presence(const ow_txn_t *t, uint16_t slot);
+
+// Execução por DMA (não bloqueia)
+void ow_start(ow_txn_t *t);
+bool ow_busy(void);
+
+// Busca de ROM (bloqueante, para a inicialização); retorna os encontrados
+int ow_search(uint64_t *roms, int max);
+
+uint8_t ow_crc8(const uint8_t *data, int len);
+
+#endif
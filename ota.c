@@ -0,0 +1,235 @@
+/**
+ * Atualização do firmware pela USB (patch, área de preparo e instalação)
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "hardware/structs/scb.h"
+#include "ota.h"
+#include "crc.h"
+#include "log.h"
+#include "persist.h"
+
+#define OTA_STAGE_OFFSET    (PICO_FLASH_SIZE_BYTES / 2)
+#define OTA_SLOT_SIZE       (PICO_FLASH_SIZE_BYTES / 2 - PERSIST_SECTORS * FLASH_SECTOR_SIZE)
+
+// Operações do patch
+#define OP_NONE     0
+#define OP_COPY     'C'     // u32 origem, u32 tamanho: bytes da imagem atual
+#define OP_LITERAL  'L'     // u16 tamanho e os bytes
+
+typedef enum { OTA_IDLE, OTA_RECEIVING, OTA_VERIFIED } ota_state_t;
+
+static struct {
+    uint8_t state;
+    uint32_t new_size, new_crc;
+    uint32_t out_pos;               // Bytes da imagem nova já gerados
+    uint16_t next_seq;
+
+    // Operação do patch em andamento (pode atravessar quadros)
+    uint8_t op;
+    uint8_t hdr[8];
+    uint8_t hdr_len;
+    uint32_t src, remaining;
+
+    // Quadro de dados sendo consumido
+    uint8_t chunk[OTA_CHUNK_MAX];
+    uint16_t chunk_len, chunk_pos, chunk_seq;
+    bool chunk_pending;
+} ota;
+
+static uint8_t page[FLASH_PAGE_SIZE];   // Página da imagem nova em montagem
+
+static void reply(char type, const char *status, uint32_t value) {
+    LOG("OTA %c %s %u", type, status, value);
+}
+
+static void fail(char type, const char *status) {
+    ota.state = OTA_IDLE;
+    ota.chunk_pending = false;
+    reply(type, status, ota.out_pos);
+}
+
+// Grava a página montada; o setor é apagado ao entrar nele
+static void program_page(uint32_t offset) {
+    uint32_t irq = save_and_disable_interrupts();
+    if (offset % FLASH_SECTOR_SIZE == 0) flash_range_erase(offset, FLASH_SECTOR_SIZE);
+    flash_range_program(offset, page, FLASH_PAGE_SIZE);
+    restore_interrupts(irq);
+}
+
+// Acrescenta um byte à imagem nova; true quando uma página foi gravada
+static bool out_byte(uint8_t b) {
+    page[ota.out_pos % FLASH_PAGE_SIZE] = b;
+    ota.out_pos++;
+    if (ota.out_pos % FLASH_PAGE_SIZE) return false;
+    program_page(OTA_STAGE_OFFSET + ota.out_pos - FLASH_PAGE_SIZE);
+    return true;
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// Consome o quadro de dados pendente, até OTA_PAGES_PER_POLL páginas; a
+// confirmação sai quando o quadro e a cópia que ele iniciou terminam
+static void consume_chunk(void) {
+    int pages = 0;
+    while (pages < OTA_PAGES_PER_POLL) {
+        if (ota.op == OP_NONE) {
+            // Código da próxima operação
+            if (ota.chunk_pos == ota.chunk_len) break;
+            ota.op = ota.chunk[ota.chunk_pos++];
+            ota.hdr_len = 0;
+            if (ota.op != OP_COPY && ota.op != OP_LITERAL) {
+                fail('D', "erro-patch");
+                return;
+            }
+            continue;
+        }
+        uint8_t need = ota.op == OP_COPY ? 8 : 2;
+        if (ota.hdr_len < need) {
+            // Cabeçalho da operação (pode vir dividido entre quadros)
+            if (ota.chunk_pos == ota.chunk_len) break;
+            ota.hdr[ota.hdr_len++] = ota.chunk[ota.chunk_pos++];
+            if (ota.hdr_len < need) continue;
+            if (ota.op == OP_COPY) {
+                ota.src = get_u32(ota.hdr);
+                ota.remaining = get_u32(ota.hdr + 4);
+                if (ota.src > OTA_SLOT_SIZE || ota.remaining > OTA_SLOT_SIZE - ota.src) {
+                    fail('D', "erro-patch");
+                    return;
+                }
+            } else {
+                ota.remaining = ota.hdr[0] | ota.hdr[1] << 8;
+            }
+        } else if (ota.remaining == 0) {
+            ota.op = OP_NONE;
+        } else if (ota.out_pos >= ota.new_size) {
+            fail('D', "erro-tamanho");
+            return;
+        } else if (ota.op == OP_COPY) {
+            pages += out_byte(*(const uint8_t *)(uintptr_t)(XIP_BASE + ota.src++));
+            ota.remaining--;
+        } else {
+            if (ota.chunk_pos == ota.chunk_len) break;
+            pages += out_byte(ota.chunk[ota.chunk_pos++]);
+            ota.remaining--;
+        }
+    }
+    if (ota.op != OP_NONE && ota.hdr_len == (ota.op == OP_COPY ? 8 : 2) && ota.remaining == 0) {
+        ota.op = OP_NONE;
+    }
+    bool copying = ota.op == OP_COPY && ota.hdr_len == 8;
+    if (ota.chunk_pos == ota.chunk_len && !copying) {
+        ota.chunk_pending = false;
+        ota.next_seq++;
+        reply('D', "ok", ota.chunk_seq);
+    }
+}
+
+// Copia a área de preparo para o início da flash e reinicia. Roda da RAM
+// com as interrupções desligadas: depois do primeiro apagamento não há
+// mais código válido na flash a partir do offset 0
+static void __no_inline_not_in_flash_func(ota_install)(uint32_t size) {
+    static uint32_t sector[FLASH_SECTOR_SIZE / 4];
+    save_and_disable_interrupts();
+    flash_range_erase(0, FLASH_SECTOR_SIZE);
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        // 1ª passada: setores 1 em diante; 2ª: o setor 0
+        uint32_t first = pass ? 0 : FLASH_SECTOR_SIZE;
+        uint32_t last = pass ? FLASH_SECTOR_SIZE : size;
+        for (uint32_t off = first; off < last; off += FLASH_SECTOR_SIZE) {
+            const uint32_t *src = (const uint32_t *)(uintptr_t)(XIP_BASE + OTA_STAGE_OFFSET + off);
+            for (uint32_t i = 0; i < FLASH_SECTOR_SIZE / 4; i++) sector[i] = src[i];
+            if (off) flash_range_erase(off, FLASH_SECTOR_SIZE);
+            flash_range_program(off, (const uint8_t *)sector, FLASH_SECTOR_SIZE);
+        }
+    }
+    scb_hw->aircr = 0x05FA0004;     // VECTKEY | SYSRESETREQ
+    while (1) {
+    }
+}
+
+void ota_frame(const uint8_t *f, uint32_t len) {
+    switch (f[0]) {
+        case 'B': {
+            if (len < 17) return;
+            uint32_t new_size = get_u32(f + 1), new_crc = get_u32(f + 5);
+            uint32_t old_size = get_u32(f + 9), old_crc = get_u32(f + 13);
+            if (new_size == 0 || new_size > OTA_SLOT_SIZE || old_size > OTA_SLOT_SIZE) {
+                fail('B', "erro-tamanho");
+            } else if (crc32_copy(NULL, (const void *)(uintptr_t)XIP_BASE, old_size) != old_crc) {
+                fail('B', "erro-base");     // Patch feito contra outra imagem
+            } else {
+                memset(&ota, 0, sizeof(ota));
+                ota.state = OTA_RECEIVING;
+                ota.new_size = new_size;
+                ota.new_crc = new_crc;
+                reply('B', "ok", new_size);
+            }
+            break;
+        }
+        case 'D': {
+            if (ota.state != OTA_RECEIVING || len < 3 || len - 3 > OTA_CHUNK_MAX) return;
+            uint16_t seq = f[1] | f[2] << 8;
+            if (seq == (uint16_t)(ota.next_seq - 1)) {
+                reply('D', "ok", seq);      // Confirmação anterior perdida
+            } else if (seq != ota.next_seq) {
+                fail('D', "erro-sequencia");
+            } else {
+                memcpy(ota.chunk, f + 3, len - 3);
+                ota.chunk_len = len - 3;
+                ota.chunk_pos = 0;
+                ota.chunk_seq = seq;
+                ota.chunk_pending = true;
+            }
+            break;
+        }
+        case 'E': {
+            if (ota.state != OTA_RECEIVING) {
+                if (ota.state == OTA_VERIFIED) reply('E', "ok", ota.new_crc);
+                return;
+            }
+            if (ota.op != OP_NONE || ota.out_pos != ota.new_size) {
+                fail('E', "erro-tamanho");
+                return;
+            }
+            // Última página incompleta, completada com 0xFF
+            uint32_t tail = ota.out_pos % FLASH_PAGE_SIZE;
+            if (tail) {
+                memset(page + tail, 0xFF, FLASH_PAGE_SIZE - tail);
+                program_page(OTA_STAGE_OFFSET + ota.out_pos - tail);
+            }
+            const void *stage = (const void *)(uintptr_t)(XIP_BASE + OTA_STAGE_OFFSET);
+            if (crc32_copy(NULL, stage, ota.new_size) != ota.new_crc) {
+                fail('E', "erro-crc");
+            } else {
+                ota.state = OTA_VERIFIED;
+                reply('E', "ok", ota.new_crc);
+            }
+            break;
+        }
+        case 'A':
+            if (ota.state != OTA_VERIFIED) {
+                reply('A', "erro-estado", 0);
+                return;
+            }
+            reply('A', "ok", ota.new_size);
+            log_flush();
+            stdio_flush();
+            sleep_ms(100);                  // A confirmação sai pela USB
+            ota_install(ota.new_size);
+            break;
+    }
+}
+
+void ota_poll(void) {
+    if (ota.chunk_pending) consume_chunk();
+}
+
+bool ota_busy(void) {
+    return ota.chunk_pending;
+}
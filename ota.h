@@ -0,0 +1,39 @@
+/**
+ * Atualização do firmware pela USB com patch contra a imagem em execução
+ *
+ * O RP2040 sempre dá boot do início da flash, então as duas "slots" são a
+ * imagem em execução (offset 0) e uma área de preparo na metade de cima da
+ * flash (abaixo dos setores de persist.c). tools/ota.py gera um patch da
+ * imagem nova contra a que está rodando (operações de cópia da imagem atual
+ * e de bytes literais) e o envia pela serial da USB em quadros COBS com
+ * CRC-16 (recebidos por link.c), um por vez, esperando a confirmação de
+ * cada um:
+ *   'B' início: tamanho e CRC-32 da imagem nova e da imagem base
+ *   'D' dados:  sequência + até OTA_CHUNK_MAX bytes do patch
+ *   'E' fim:    a imagem montada na área de preparo é conferida pelo CRC-32
+ *   'A' aplicar: copia a área de preparo para o início e reinicia
+ * As respostas saem pelo log (LOG "OTA <tipo> <estado> <valor>").
+ *
+ * A montagem roda no loop principal, algumas páginas por vez, com a
+ * amostragem funcionando (cada apagamento de setor atrasa o timer ~50 ms,
+ * como em persist.c). Só a aplicação para o aparelho: a cópia roda da RAM
+ * com as interrupções desligadas e o aparelho fica fora do ar por alguns
+ * segundos. O setor 0 (boot2 e vetores) é apagado primeiro e gravado por
+ * último: uma queda de energia no meio deixa o RP2040 no modo BOOTSEL,
+ * recuperável por UF2 como antes.
+ */
+
+#ifndef OTA_H
+#define OTA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define OTA_CHUNK_MAX       256     // Bytes do patch por quadro
+#define OTA_PAGES_PER_POLL  4       // Páginas gravadas por chamada do ota_poll()
+
+void ota_frame(const uint8_t *f, uint32_t len);    // Quadro 'B', 'D', 'E' ou 'A' (sem o CRC)
+void ota_poll(void);    // Loop principal: monta a imagem com o quadro pendente
+bool ota_busy(void);    // Ainda há trabalho pendente (não dormir no __wfi)
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * Estado persistente nos últimos setores da flash
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "persist.h"
+#include "crc.h"
+
+#define PERSIST_OFFSET      (PICO_FLASH_SIZE_BYTES - PERSIST_SECTORS * FLASH_SECTOR_SIZE)
+#define PERSIST_SLOTS       (int)(PERSIST_SECTORS * FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+#define PERSIST_MAGIC       0x50455253u     // "PERS"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;
+    uint16_t len;
+    uint16_t reserved;
+    uint32_t crc;                           // CRC-32 de len bytes de data
+    uint8_t data[PERSIST_MAX_LEN];
+} persist_record_t;
+
+_Static_assert(sizeof(persist_record_t) == FLASH_PAGE_SIZE, "um registro por página");
+
+static int last_slot = -1;                  // Slot do registro mais novo
+static uint32_t last_seq = 0;
+
+static const persist_record_t *slot_ptr(int slot) {
+    return (const persist_record_t *)(uintptr_t)(XIP_BASE + PERSIST_OFFSET + slot * FLASH_PAGE_SIZE);
+}
+
+static bool slot_valid(const persist_record_t *r) {
+    return r->magic == PERSIST_MAGIC && r->len <= PERSIST_MAX_LEN && crc32_copy(NULL, r->data, r->len) == r->crc;
+}
+
+// Procura o registro mais novo; false se não houver nenhum válido
+bool persist_load(void *data, size_t len) {
+    for (int i = 0; i < PERSIST_SLOTS; i++) {
+        const persist_record_t *r = slot_ptr(i);
+        if (slot_valid(r) && (last_slot < 0 || (int32_t)(r->seq - last_seq) > 0)) {
+            last_slot = i;
+            last_seq = r->seq;
+        }
+    }
+    if (last_slot < 0) return false;
+
+    const persist_record_t *r = slot_ptr(last_slot);
+    if (r->len != len) return false;        // Formato mudou: começa do zero
+    memcpy(data, r->data, len);
+    return true;
+}
+
+void persist_save(const void *data, size_t len) {
+    static persist_record_t rec;
+    if (len > PERSIST_MAX_LEN) return;
+
+    memset(&rec, 0xFF, sizeof(rec));
+    rec.magic = PERSIST_MAGIC;
+    rec.seq = last_seq + 1;
+    rec.len = len;
+    rec.crc = crc32_copy(rec.data, data, len); // Cópia por DMA, CRC no sniffer
+
+    // Próximo slot; ao entrar num setor novo ele é apagado antes
+    int slot = (last_slot + 1) % PERSIST_SLOTS;
+    uint32_t offset = PERSIST_OFFSET + slot * FLASH_PAGE_SIZE;
+
+    uint32_t irq = save_and_disable_interrupts();
+    if (offset % FLASH_SECTOR_SIZE == 0) flash_range_erase(offset, FLASH_SECTOR_SIZE);
+    flash_range_program(offset, (const uint8_t *)&rec, FLASH_PAGE_SIZE);
+    restore_interrupts(irq);
+
+    last_slot = slot;
+    last_seq = rec.seq;
+}
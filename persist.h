@@ -0,0 +1,28 @@
+/**
+ * Estado persistente nos últimos setores da flash
+ *
+ * Os registros são gravados em sequência, uma página (256 bytes) por
+ * gravação, alternando entre dois setores: só se apaga um setor quando o
+ * outro já tem o registro mais novo, então um reset no meio da gravação
+ * nunca perde o estado anterior. Na leitura vale o registro válido (marca
+ * e CRC) de maior número de sequência.
+ *
+ * A gravação desliga as interrupções e o XIP: deve ser chamada do loop
+ * principal, sem DMA lendo da flash. O apagamento de um setor (~50 ms)
+ * atrasa o timer de amostragem, por isso as gravações são espaçadas.
+ */
+
+#ifndef PERSIST_H
+#define PERSIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PERSIST_SECTORS 2       // Setores no fim da flash (a área de ota.c fica abaixo)
+#define PERSIST_MAX_LEN 240     // Dados por registro (página menos o cabeçalho)
+
+bool persist_load(void *data, size_t len);
+void persist_save(const void *data, size_t len);
+
+#endif
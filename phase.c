@@ -0,0 +1,96 @@
+/**
+ * Fase da compostagem e acumuladores de permanência
+ */
+
+#include <math.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "phase.h"
+#include "persist.h"
+#include "alarms.h"
+#include "screens.h"
+
+phase_state_t phase;
+
+static uint32_t ms_acc = 0;             // Fração de segundo ainda não contada
+static uint32_t since_save_s = 0;
+static volatile bool save_due = false;
+
+void phase_init(void) {
+    if (!persist_load(&phase, sizeof(phase)) || phase.phase >= PHASE_COUNT) {
+        memset(&phase, 0, sizeof(phase));
+        phase.peak = INT16_MIN;
+    }
+    screens_notify(DATA_PHASE);
+}
+
+static void phase_enter(phase_id_t id) {
+    if (id == PHASE_THERMOPHILIC) phase.cycles++;
+    phase.phase = id;
+    phase.phase_s = 0;
+    save_due = true;
+}
+
+// Chamada a cada temperatura filtrada (no callback do timer)
+void phase_add(float temp, float rate, uint32_t period_ms) {
+    ms_acc += period_ms;
+    uint32_t dt = ms_acc / 1000;
+    ms_acc %= 1000;
+
+    // 1. Acumuladores de permanência
+    phase.phase_s += dt;
+    if (temp >= PHASE_KILL_C) phase.kill_s += dt;
+    if (temp < PHASE_MATURE_C && fabsf(rate) < PHASE_MATURE_RATE) phase.stable_s += dt;
+    else phase.stable_s = 0;
+    int16_t centi = (int16_t)(temp * 100.0f);
+    if (centi > phase.peak) phase.peak = centi;
+
+    // 2. Transições
+    switch (phase.phase) {
+        case PHASE_MESOPHILIC:
+            if (temp >= PHASE_THERMO_C) phase_enter(PHASE_THERMOPHILIC);
+            break;
+        case PHASE_THERMOPHILIC:
+            if (temp < PHASE_THERMO_C - PHASE_HYST_C && rate < 0.0f) phase_enter(PHASE_COOLING);
+            break;
+        case PHASE_COOLING:
+            // Reaquecimento depois de revirar a leira
+            if (temp >= PHASE_THERMO_C) phase_enter(PHASE_THERMOPHILIC);
+            else if (phase.stable_s >= PHASE_MATURE_H * 3600) phase_enter(PHASE_MATURATION);
+            break;
+        case PHASE_MATURATION:
+            if (temp >= PHASE_THERMO_C) phase_enter(PHASE_THERMOPHILIC);
+            break;
+    }
+
+    // 3. Alarmes do processo
+    alarm_set(ALARM_OVERHEAT, temp > PHASE_OVERHEAT_C);
+    alarm_set(ALARM_SANITATION, phase.phase == PHASE_COOLING && phase.kill_s < PHASE_KILL_H * 3600);
+
+    since_save_s += dt;
+    if (since_save_s >= PHASE_SAVE_S) save_due = true;
+    screens_notify(DATA_PHASE);
+}
+
+// Loop principal: grava o estado na flash quando a fase muda ou a cada
+// PHASE_SAVE_S (fora das interrupções e sem DMA lendo da flash)
+void phase_poll(void) {
+    if (!save_due) return;
+    uint32_t irq = save_and_disable_interrupts();
+    phase_state_t copy = phase;
+    save_due = false;
+    since_save_s = 0;
+    restore_interrupts(irq);
+    persist_save(&copy, sizeof(copy));
+}
+
+const char *phase_name(phase_id_t id) {
+    switch (id) {
+        case PHASE_MESOPHILIC:   return "MESOFILICA";
+        case PHASE_THERMOPHILIC: return "TERMOFILICA";
+        case PHASE_COOLING:      return "RESFRIANDO";
+        case PHASE_MATURATION:   return "MATURACAO";
+        default:                 return "--";
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * Fase da compostagem, classificada a cada amostra filtrada
+ *
+ * Usa a temperatura filtrada, a taxa de aquecimento do ajuste de predict.c
+ * e acumuladores de permanência, todos atualizados em tempo constante:
+ *   MESOFÍLICA   - aquecendo abaixo de PHASE_THERMO_C
+ *   TERMOFÍLICA  - acima de PHASE_THERMO_C
+ *   RESFRIAMENTO - caiu abaixo do limiar depois da fase termofílica
+ *   MATURAÇÃO    - estável abaixo de PHASE_MATURE_C por PHASE_MATURE_H
+ *
+ * O tempo acumulado acima de 55°C (sanitização) e a fase sobrevivem a
+ * resets: o estado é gravado na flash (persist.c) periodicamente e a cada
+ * troca de fase. O tempo com o aparelho desligado não é contado.
+ */
+
+#ifndef PHASE_H
+#define PHASE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PHASE_THERMO_C      45.0f   // Início da fase termofílica
+#define PHASE_HYST_C        2.0f    // Histerese da volta para baixo do limiar
+#define PHASE_KILL_C        55.0f   // Sanitização (eliminação de patógenos)
+#define PHASE_KILL_H        72.0f   // Horas acima de 55°C exigidas
+#define PHASE_OVERHEAT_C    70.0f   // Acima disso a leira precisa ser revirada
+#define PHASE_MATURE_C      35.0f
+#define PHASE_MATURE_RATE   0.2f    // Taxa considerada estável (°C/h)
+#define PHASE_MATURE_H      24.0f
+#define PHASE_SAVE_S        600     // Intervalo entre gravações na flash
+
+typedef enum {
+    PHASE_MESOPHILIC,
+    PHASE_THERMOPHILIC,
+    PHASE_COOLING,
+    PHASE_MATURATION,
+    PHASE_COUNT
+} phase_id_t;
+
+// Estado gravado na flash (o formato muda = começa do zero)
+typedef struct {
+    uint8_t phase;              // phase_id_t
+    uint8_t reserved[3];
+    uint32_t phase_s;           // Tempo na fase atual
+    uint32_t kill_s;            // Tempo acumulado acima de PHASE_KILL_C
+    uint32_t stable_s;          // Tempo contínuo na condição de maturação
+    int16_t peak;               // Maior temperatura (centésimos de °C)
+    uint16_t cycles;            // Entradas na fase termofílica (reviradas)
+} phase_state_t;
+
+extern phase_state_t phase;
+
+void phase_init(void);
+void phase_add(float temp, float rate, uint32_t period_ms);
+void phase_poll(void);          // Loop principal: grava quando necessário
+const char *phase_name(phase_id_t id);
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * Modelo térmico da leira de compostagem
+ */
+
+#include <math.h>
+#include "plant.h"
+
+#define PLANT_MAX_STEP_S    60.0f   // Passo máximo da integração (Euler)
+
+// Curva de temperatura cardinal (Rosso): 0 fora de (t_min, t_max), 1 em t_opt
+static float cardinal(const plant_params_t *p, float t) {
+    if (t <= p->t_min || t >= p->t_max) return 0.0f;
+    float span = p->t_opt - p->t_min;
+    float den = span * (span * (t - p->t_opt) - (p->t_opt - p->t_max) * (p->t_opt + p->t_min - 2.0f * t));
+    return (t - p->t_max) * (t - p->t_min) * (t - p->t_min) / den;
+}
+
+void plant_init(plant_t *pl, const plant_params_t *p) {
+    pl->p = *p;
+    pl->hours = 0.0;
+    pl->substrate = 1.0f;
+    pl->activity = 0.0f;
+    pl->core = pl->probe = plant_ambient(pl);
+}
+
+// Ambiente com o ciclo diário (mínimo às 3 h, máximo às 15 h)
+float plant_ambient(const plant_t *pl) {
+    float day = (float)fmod(pl->hours, 24.0);
+    return pl->p.ambient - pl->p.ambient_amp * cosf((day - 3.0f) * (float)(M_PI / 12.0));
+}
+
+void plant_step(plant_t *pl, float dt_s, float blower) {
+    const plant_params_t *p = &pl->p;
+    if (blower < 0.0f) blower = 0.0f;
+    if (blower > 1.0f) blower = 1.0f;
+    while (dt_s > 0.0f) {
+        float h = dt_s < PLANT_MAX_STEP_S ? dt_s : PLANT_MAX_STEP_S;
+        dt_s -= h;
+        float dt_h = h / 3600.0f;
+
+        // 1. Atividade: temperatura, oxigênio e substrato
+        float o2 = p->o2_passive + blower;
+        pl->activity = cardinal(p, pl->core) * o2 / (p->o2_k + o2) * pl->substrate;
+
+        // 2. Balanço de calor do núcleo
+        float amb = plant_ambient(pl);
+        float cool = (p->loss + p->aeration * blower) * (pl->core - amb);
+        pl->core += (p->heat_max * pl->activity - cool) * dt_h;
+        pl->substrate -= pl->activity / p->substrate_h * dt_h;
+        if (pl->substrate < 0.0f) pl->substrate = 0.0f;
+
+        // 3. Sonda atrasada em relação ao núcleo
+        pl->probe += (pl->core - pl->probe) * (1.0f - expf(-h / p->probe_tau_s));
+        pl->hours += dt_h;
+    }
+}
+
+float plant_diode_voltage(const plant_t *pl) {
+    return PLANT_DIODE_V0 + PLANT_DIODE_K * pl->probe;
+}
@@ -0,0 +1,68 @@
+/**
+ * Modelo térmico da leira de compostagem
+ *
+ * Usado pelo backend simulado (-DACQ_BACKEND=sim, acq_sim.c) para testar
+ * filtro, alarmes e controle sem uma leira de verdade: no computador, em
+ * tempo virtual (tools/plant_sim.py, meses em segundos), ou na bancada,
+ * em tempo real. Uma temperatura do núcleo, com:
+ *  - autoaquecimento da atividade microbiana: curva de temperatura cardinal
+ *    (zero abaixo de t_min e acima de t_max, máximo em t_opt), limitada pelo
+ *    oxigênio (difusão passiva mais o soprador) e pelo substrato restante,
+ *    que se esgota com a própria atividade;
+ *  - troca com o ambiente (ciclo diário) e resfriamento pelo ar do soprador
+ *    (calor sensível e evaporação, proporcionais à vazão);
+ *  - atraso da sonda em relação ao núcleo (primeira ordem).
+ * As taxas estão em °C/h, sem massa nem calor específico explícitos.
+ */
+
+#ifndef PLANT_H
+#define PLANT_H
+
+#include <stdint.h>
+
+// Lei do diodo de sensor.c, invertida (tensão a partir da temperatura)
+#define PLANT_DIODE_V0      0.6264f
+#define PLANT_DIODE_K       (-0.0021f)
+
+typedef struct {
+    float heat_max;         // Aquecimento com atividade máxima (°C/h)
+    float t_min, t_opt, t_max;  // Temperaturas cardinais da atividade (°C)
+    float o2_passive;       // Oxigênio por difusão, em vazões do soprador
+    float o2_k;             // Meia saturação do oxigênio
+    float substrate_h;      // Horas de atividade máxima até esgotar o substrato
+    float loss;             // Troca com o ambiente (1/h)
+    float aeration;         // Resfriamento com o soprador no máximo (1/h)
+    float ambient;          // Média do ambiente (°C)
+    float ambient_amp;      // Amplitude do ciclo diário (°C, máximo às 15 h)
+    float probe_tau_s;      // Constante de tempo da sonda (s)
+} plant_params_t;
+
+#define PLANT_DEFAULTS {                                                    \
+    .heat_max = 3.0f, .t_min = 5.0f, .t_opt = 58.0f, .t_max = 75.0f,        \
+    .o2_passive = 0.15f, .o2_k = 0.1f, .substrate_h = 1500.0f,              \
+    .loss = 0.03f, .aeration = 0.6f,                                        \
+    .ambient = 25.0f, .ambient_amp = 6.0f, .probe_tau_s = 180.0f,           \
+}
+
+typedef struct {
+    plant_params_t p;
+    double hours;           // Tempo simulado
+    float core;             // Temperatura do núcleo (°C)
+    float probe;            // Temperatura na sonda (°C)
+    float substrate;        // Fração restante do substrato (1 a 0)
+    float activity;         // Atividade atual (0 a 1)
+} plant_t;
+
+void plant_init(plant_t *pl, const plant_params_t *p);
+// Avança dt_s segundos com o soprador em blower (0 a 1)
+void plant_step(plant_t *pl, float dt_s, float blower);
+float plant_ambient(const plant_t *pl);
+float plant_diode_voltage(const plant_t *pl);
+
+// Backend simulado (acq_sim.c): parâmetros lidos no init e a leira em uso
+extern plant_params_t acq_sim_params;
+extern float acq_sim_noise_lsb;     // Ruído do conversor (desvio, em LSB)
+extern uint32_t acq_sim_seed;
+extern plant_t acq_sim_plant;
+
+#endif
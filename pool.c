@@ -0,0 +1,78 @@
+/**
+ * Pools de blocos de tamanho fixo com lista livre
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "pool.h"
+
+// Blocos em palavras: alinhados e com espaço para o elo da lista livre
+#define POOL_WORDS(size) (((size) + 3) / 4)
+
+#define POOL_STORAGE(id, size, count) static uint32_t pool_storage_##id[(count) * POOL_WORDS(size)];
+POOL_LIST(POOL_STORAGE)
+
+typedef struct {
+    const char *name;
+    uint32_t *storage;
+    uint16_t words;             // Palavras por bloco
+    uint16_t count;
+} pool_def_t;
+
+#define POOL_DEF(id, size, count) [id] = { #id, pool_storage_##id, POOL_WORDS(size), count },
+static const pool_def_t defs[POOL_COUNT] = { POOL_LIST(POOL_DEF) };
+
+volatile pool_stats_t pool_stats[POOL_COUNT];
+
+static void *free_head[POOL_COUNT];
+static spin_lock_t *lock;
+
+void pool_init(void) {
+    lock = spin_lock_instance(spin_lock_claim_unused(true));
+    for (uint32_t id = 0; id < POOL_COUNT; id++) {
+        const pool_def_t *d = &defs[id];
+        void *next = NULL;
+        for (uint32_t i = d->count; i-- > 0;) {
+            uint32_t *b = d->storage + i * d->words;
+            *(void **)b = next;
+            next = b;
+        }
+        free_head[id] = next;
+    }
+}
+
+void *pool_alloc(pool_id_t id) {
+    volatile pool_stats_t *st = &pool_stats[id];
+    uint32_t irq = spin_lock_blocking(lock);
+    void *b = free_head[id];
+    if (b) {
+        free_head[id] = *(void **)b;
+        if (++st->in_use > st->high_water) st->high_water = st->in_use;
+    } else {
+        st->failures++;
+    }
+    spin_unlock(lock, irq);
+    return b;
+}
+
+void pool_free(pool_id_t id, void *p) {
+    if (!p) return;
+    const pool_def_t *d = &defs[id];
+    uint32_t off = (uint32_t)((uint32_t *)p - d->storage);
+    if ((uint32_t *)p < d->storage || off >= (uint32_t)d->count * d->words || off % d->words) {
+        panic("pool_free: bloco fora de %s", d->name);
+    }
+    uint32_t irq = spin_lock_blocking(lock);
+    *(void **)p = free_head[id];
+    free_head[id] = p;
+    pool_stats[id].in_use--;
+    spin_unlock(lock, irq);
+}
+
+const char *pool_name(pool_id_t id) {
+    return defs[id].name;
+}
+
+uint16_t pool_capacity(pool_id_t id) {
+    return defs[id].count;
+}
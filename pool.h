@@ -0,0 +1,47 @@
+/**
+ * Pools de blocos de tamanho fixo (a memória dinâmica do firmware)
+ *
+ * O firmware não usa heap: o build falha se malloc/free da newlib entrarem
+ * no ELF (tools/check_heap.py, opção HEAP_GUARD do CMake). Quem precisa de
+ * memória sob demanda pede um bloco de um dos pools abaixo, dimensionados
+ * na compilação e alocados estaticamente (pool_storage_<id> no .bss).
+ *
+ * Sem fragmentação por construção: cada pool só tem blocos de um tamanho e
+ * qualquer bloco livre atende qualquer pedido daquele pool, então a única
+ * falha possível é o pool esgotado (mais de count blocos em uso ao mesmo
+ * tempo), contada em failures; o pior caso de memória é a soma de
+ * tamanho × count da lista, conhecida no link. Os blocos livres formam uma
+ * lista ligada pelo primeiro campo: alocar e liberar são O(1). O M0+ não
+ * tem LDREX/STREX, então as duas operações rodam sob um spin lock de
+ * hardware do SIO (poucas instruções, com as interrupções do núcleo
+ * desligadas), seguras entre os núcleos e as interrupções.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+#include "block.h"
+
+// Pools: identificador, tamanho do bloco (bytes) e número de blocos
+#define POOL_LIST(X)                                                        \
+    X(POOL_SAMPLES, sizeof(block_t), BLOCK_COUNT)   /* Blocos de amostras (block.c) */
+
+#define POOL_ENUM(id, size, count) id,
+typedef enum { POOL_LIST(POOL_ENUM) POOL_COUNT } pool_id_t;
+
+typedef struct {
+    uint16_t in_use;            // Blocos alocados agora
+    uint16_t high_water;        // Maior ocupação desde o boot
+    uint32_t failures;          // Pedidos com o pool esgotado
+} pool_stats_t;
+
+extern volatile pool_stats_t pool_stats[POOL_COUNT];
+
+void pool_init(void);
+void *pool_alloc(pool_id_t id);             // NULL com o pool esgotado
+void pool_free(pool_id_t id, void *p);      // Bloco de outro pool: panic
+const char *pool_name(pool_id_t id);
+uint16_t pool_capacity(pool_id_t id);
+
+#endif
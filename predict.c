@@ -0,0 +1,80 @@
+/**
+ * Previsão do tempo até os limiares (mínimos quadrados recursivos)
+ */
+
+#include <math.h>
+#include "predict.h"
+#include "screens.h"
+
+predict_t predict;
+
+// Somas ponderadas com a origem do tempo (h) na amostra mais recente e as
+// temperaturas relativas a ref (a última amostra), para não perder precisão
+static float s0, s1, s2;        // Σw, Σw·t, Σw·t²
+static float sy, sty, syy;      // Σw·y, Σw·t·y, Σw·y²
+static float sw2;               // Σw² (número efetivo de amostras)
+static float ref;
+static float span_h;            // Tempo coberto pelos dados
+static float corr_n = 1.0f;     // Entradas correlacionadas pelo filtro
+
+static void solve(void) {
+    float d = s0 * s2 - s1 * s1;
+    float neff = s0 * s0 / sw2;
+    predict.valid = span_h >= PREDICT_MIN_H && d > 0.0f && neff > 3.0f;
+    predict.target = predict.eta_h = predict.ci_h = 0.0f;
+    if (!predict.valid) return;
+
+    float b = (s0 * sty - s1 * sy) / d;
+    float a = (sy - b * s1) / s0;               // Nível ajustado agora (relativo a ref)
+    predict.level = ref + a;
+    predict.rate = b;
+
+    // Variância dos resíduos e covariância de (a, b)
+    float sse = syy - a * sy - b * sty;
+    if (sse < 0.0f) sse = 0.0f;
+    float var = sse / s0 * neff / (neff - 2.0f) * (sw2 / s0) * corr_n / d;
+    float var_a = var * s2, var_b = var * s0, cov = -var * s1;
+
+    // Próximo limiar no sentido da tendência, se ela for significativa
+    if (b * b <= 4.0f * var_b) return;
+    if (b > 0.0f && predict.level < PREDICT_KILL_C) predict.target = PREDICT_KILL_C;
+    else if (b < 0.0f && predict.level > PREDICT_TURN_C) predict.target = PREDICT_TURN_C;
+    else return;
+
+    // Cruzamento t = (alvo - a) / b e sua variância (método delta)
+    float t = (predict.target - predict.level) / b;
+    float var_t = (var_a + t * t * var_b + 2.0f * t * cov) / (b * b);
+    predict.eta_h = t;
+    predict.ci_h = 2.0f * sqrtf(var_t > 0.0f ? var_t : 0.0f);
+}
+
+// Chamada a cada temperatura filtrada (no callback do timer)
+void predict_add(float temp, uint32_t period_ms, float corr) {
+    if (s0 == 0.0f) ref = temp;
+    corr_n = corr > 1.0f ? corr : 1.0f;
+
+    // 1. Desloca a origem do tempo para agora: as amostras antigas ficam em t - dt
+    float dt = period_ms / 3600000.0f;
+    s2 += dt * (dt * s0 - 2.0f * s1);
+    s1 -= dt * s0;
+    sty -= dt * sy;
+
+    // 2. Referência das temperaturas na nova amostra
+    float dy = temp - ref;
+    syy += dy * (dy * s0 - 2.0f * sy);
+    sy -= dy * s0;
+    sty -= dy * s1;
+    ref = temp;
+
+    // 3. Esquecimento exponencial e a nova amostra em (0, 0)
+    float lambda = 1.0f - dt / PREDICT_TAU_H;
+    s0 *= lambda, s1 *= lambda, s2 *= lambda;
+    sy *= lambda, sty *= lambda, syy *= lambda;
+    sw2 *= lambda * lambda;
+    s0 += 1.0f;
+    sw2 += 1.0f;
+    if (span_h < PREDICT_MIN_H) span_h += dt;
+
+    solve();
+    screens_notify(DATA_PREDICT);
+}
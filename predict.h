@@ -0,0 +1,44 @@
+/**
+ * Previsão do tempo até os limiares da compostagem
+ *
+ * Uma reta T(t) = a + b·t é ajustada à temperatura filtrada por mínimos
+ * quadrados recursivos com esquecimento exponencial (constante de tempo
+ * PREDICT_TAU_H). A cada amostra a origem do tempo é deslocada para o
+ * instante atual e as somas ponderadas são atualizadas em tempo constante,
+ * então `a` é a temperatura ajustada agora e `b` a taxa em °C/h.
+ *
+ * O alvo é o próximo limiar no sentido da tendência: 55°C (eliminação de
+ * patógenos) aquecendo, 40°C (hora de revirar) esfriando. O intervalo de
+ * confiança (±2 desvios) vem da variância dos resíduos propagada para o
+ * cruzamento da reta com o limiar; como o filtro correlaciona as amostras
+ * vizinhas, a variância é inflada pelo número de entradas correlacionadas,
+ * informado a cada amostra (a janela do filtro vista na taxa da entrada).
+ */
+
+#ifndef PREDICT_H
+#define PREDICT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PREDICT_KILL_C   55.0f  // Sanitização (patógenos)
+#define PREDICT_TURN_C   40.0f  // Abaixo disso a leira precisa ser revirada
+#define PREDICT_TAU_H    0.5f   // Memória do ajuste (constante de tempo)
+#define PREDICT_MIN_H    0.25f  // Dados mínimos antes da primeira previsão
+#define PREDICT_MAX_H    99.0f  // Cruzamentos mais distantes não são exibidos
+
+typedef struct {
+    float level;        // Temperatura ajustada agora (°C)
+    float rate;         // Taxa (°C/h)
+    float target;       // Limiar previsto (°C), 0 = nenhum
+    float eta_h;        // Tempo até o limiar (h)
+    float ci_h;         // Meia largura do intervalo de confiança (h)
+    bool valid;         // Ajuste com amostras suficientes
+} predict_t;
+
+extern predict_t predict;
+
+// corr: entradas vizinhas correlacionadas pelo filtro (>= 1)
+void predict_add(float temp, uint32_t period_ms, float corr);
+
+#endif
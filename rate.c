@@ -0,0 +1,34 @@
+/**
+ * Conversores de taxa: decimador por média e agenda do loop principal
+ */
+
+#include "rate.h"
+
+// Chamada no callback do timer, a cada entrada do estágio mais rápido
+bool rate_dec_add(rate_dec_t *d, float x, uint32_t dt_ms) {
+    if (d->count == 0) d->min = d->max = x;
+    if (x < d->min) d->min = x;
+    if (x > d->max) d->max = x;
+    d->sum += x * dt_ms;
+    d->acc_ms += dt_ms;
+    d->count++;
+    if (d->acc_ms < d->period_ms) return false;
+
+    d->mean = d->acc_ms ? d->sum / d->acc_ms : x;
+    d->lo = d->min;
+    d->hi = d->max;
+    d->out_ms = d->acc_ms;
+    d->out_count = d->count;
+    d->sum = 0.0f;
+    d->acc_ms = 0;
+    d->count = 0;
+    return true;
+}
+
+bool rate_tick_due(rate_tick_t *t, uint32_t now_ms) {
+    if (t->period_ms == 0) return true;
+    if ((int32_t)(now_ms - t->next_ms) < 0) return false;
+    t->next_ms += t->period_ms;
+    if ((int32_t)(now_ms - t->next_ms) >= 0) t->next_ms = now_ms + t->period_ms;  // Atrasou: pula
+    return true;
+}
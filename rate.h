@@ -0,0 +1,49 @@
+/**
+ * Conversores de taxa entre os estágios do pipeline da temperatura
+ *
+ * Cada estágio (aquisição, saída do filtro, tela, log, telemetria) tem o
+ * seu período, e os estágios são ligados por:
+ *  - rate_dec_t: decimador para um estágio mais lento. A saída é a média
+ *    das entradas no período, ponderada pelo tempo de cada uma (filtro
+ *    boxcar, que também corta o ruído acima da taxa de saída), com o
+ *    mínimo e o máximo. As entradas dizem quanto tempo representam, então
+ *    a entrada pode mudar de taxa (bateria fraca) sem mudar a saída;
+ *  - rate_tick_t: agenda de um estágio do loop principal, que lê o último
+ *    valor retido do estágio anterior. O alvo é absoluto (alvo += período)
+ *    e, se o loop atrasar mais de um período, as execuções perdidas são
+ *    puladas em vez de acumuladas.
+ */
+
+#ifndef RATE_H
+#define RATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t period_ms;         // Período da saída
+    // Acumuladores do período em formação
+    uint32_t acc_ms;
+    float sum, min, max;
+    uint32_t count;
+    // Última saída
+    float mean, lo, hi;
+    uint32_t out_ms;            // Tempo coberto (>= period_ms)
+    uint32_t out_count;         // Entradas somadas
+} rate_dec_t;
+
+typedef struct {
+    uint32_t period_ms;
+    uint32_t next_ms;
+} rate_tick_t;
+
+#define RATE_DEC(ms)    { .period_ms = (ms) }
+#define RATE_TICK(ms)   { .period_ms = (ms) }
+
+// Acrescenta uma entrada que vale dt_ms; true quando sai um valor novo
+bool rate_dec_add(rate_dec_t *d, float x, uint32_t dt_ms);
+
+// true quando o período venceu (a primeira chamada já vence)
+bool rate_tick_due(rate_tick_t *t, uint32_t now_ms);
+
+#endif
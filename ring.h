@@ -0,0 +1,233 @@
+/**
+ * Buffers circulares genéricos (tipo e capacidade em tempo de compilação)
+ *
+ * RING_DEFINE(nome, tipo, capacidade) gera o tipo nome_t e funções inline
+ * nome_push(), nome_pop(), nome_peek() etc. A capacidade é uma potência de
+ * 2 (conferida na compilação): os índices correm livres em 32 bits e a
+ * posição é o índice com a máscara, sem divisão (o M0+ não tem instrução
+ * de divisão e `%` por um tamanho qualquer vira chamada de biblioteca).
+ * Cheio e vazio se distinguem pela diferença head - tail, então todas as
+ * posições são usadas. Um ring zerado (variável estática) está vazio.
+ *
+ * Concorrência:
+ *  - um produtor e um consumidor (SPSC), em núcleos ou interrupções
+ *    diferentes: sem trava. Cada lado só escreve o seu índice, e a barreira
+ *    de memória antes de publicá-lo garante que o outro lado veja os dados;
+ *  - vários produtores (MPSC): nome_push_mp() faz o push sob um spin lock
+ *    de hardware do SIO. O M0+ não tem LDREX/STREX, então este é o atômico
+ *    disponível; quem precisa atualizar outro estado junto com o push (como
+ *    log.c e block.c) segura a própria trava e chama o push comum.
+ *
+ * Para DMA e cópias em bloco, nome_write_span() e nome_read_span() devolvem
+ * o maior trecho contíguo livre ou ocupado (no máximo dois por volta),
+ * confirmado depois com nome_commit() / nome_consume(); nome_push_n() e
+ * nome_pop_n() copiam vários elementos de uma vez.
+ *
+ * Em C++ o mesmo ring é o template Ring<T, N>, com os mesmos métodos.
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "hardware/sync.h"
+
+#define RING_IS_POW2(n) ((n) > 0 && ((n) & ((n) - 1)) == 0)
+
+#ifdef __cplusplus
+#define RING_STATIC_ASSERT(c, msg) static_assert(c, msg)
+#else
+#define RING_STATIC_ASSERT(c, msg) _Static_assert(c, msg)
+#endif
+
+// Trecho contíguo a partir da posição pos, limitado a avail elementos
+static inline uint32_t ring_span(uint32_t pos, uint32_t size, uint32_t avail) {
+    return avail < size - pos ? avail : size - pos;
+}
+
+#define RING_DEFINE(name, type, size)                                           \
+    RING_STATIC_ASSERT(RING_IS_POW2(size), #name ": capacidade deve ser potência de 2"); \
+    typedef struct {                                                            \
+        type buf[size];                                                         \
+        volatile uint32_t head;     /* Escrito só pelo produtor */              \
+        volatile uint32_t tail;     /* Escrito só pelo consumidor */            \
+    } name##_t;                                                                 \
+                                                                                \
+    static inline uint32_t name##_count(const name##_t *r) {                    \
+        return r->head - r->tail;                                               \
+    }                                                                           \
+    static inline uint32_t name##_space(const name##_t *r) {                    \
+        return (size) - (r->head - r->tail);                                    \
+    }                                                                           \
+    /* Produtor: false com o ring cheio */                                      \
+    static inline bool name##_push(name##_t *r, type x) {                       \
+        uint32_t h = r->head;                                                   \
+        if (h - r->tail == (size)) return false;                                \
+        r->buf[h & ((size) - 1)] = x;                                           \
+        __dmb();                                                                \
+        r->head = h + 1;                                                        \
+        return true;                                                            \
+    }                                                                           \
+    /* Consumidor: false com o ring vazio */                                    \
+    static inline bool name##_pop(name##_t *r, type *x) {                       \
+        uint32_t t = r->tail;                                                   \
+        if (r->head == t) return false;                                         \
+        __dmb();                                                                \
+        *x = r->buf[t & ((size) - 1)];                                          \
+        __dmb();                                                                \
+        r->tail = t + 1;                                                        \
+        return true;                                                            \
+    }                                                                           \
+    /* Elemento já escrito (age = 0 é o mais recente); age < count */           \
+    static inline type name##_peek(const name##_t *r, uint32_t age) {           \
+        return r->buf[(r->head - 1 - age) & ((size) - 1)];                      \
+    }                                                                           \
+    /* Trecho contíguo livre a partir do head, confirmado por commit */         \
+    static inline uint32_t name##_write_span(name##_t *r, type **p) {           \
+        uint32_t pos = r->head & ((size) - 1);                                  \
+        *p = &r->buf[pos];                                                      \
+        return ring_span(pos, (size), name##_space(r));                         \
+    }                                                                           \
+    static inline void name##_commit(name##_t *r, uint32_t n) {                 \
+        __dmb();                                                                \
+        r->head += n;                                                           \
+    }                                                                           \
+    /* Trecho contíguo ocupado a partir do tail, liberado por consume */        \
+    static inline uint32_t name##_read_span(name##_t *r, type **p) {            \
+        uint32_t pos = r->tail & ((size) - 1);                                  \
+        uint32_t n = ring_span(pos, (size), name##_count(r));                   \
+        __dmb();                                                                \
+        *p = &r->buf[pos];                                                      \
+        return n;                                                               \
+    }                                                                           \
+    static inline void name##_consume(name##_t *r, uint32_t n) {                \
+        __dmb();                                                                \
+        r->tail += n;                                                           \
+    }                                                                           \
+    /* Copia n elementos de uma vez; false (nada escrito) sem espaço */         \
+    static inline bool name##_push_n(name##_t *r, const type *src, uint32_t n) { \
+        if (name##_space(r) < n) return false;                                  \
+        type *p;                                                                \
+        uint32_t first = name##_write_span(r, &p);                              \
+        if (first > n) first = n;                                               \
+        memcpy(p, src, first * sizeof(type));                                   \
+        memcpy(r->buf, src + first, (n - first) * sizeof(type));                \
+        name##_commit(r, n);                                                    \
+        return true;                                                            \
+    }                                                                           \
+    /* Retira até n elementos; devolve quantos */                               \
+    static inline uint32_t name##_pop_n(name##_t *r, type *dst, uint32_t n) {   \
+        uint32_t count = name##_count(r);                                       \
+        if (n > count) n = count;                                               \
+        type *p;                                                                \
+        uint32_t first = name##_read_span(r, &p);                               \
+        if (first > n) first = n;                                               \
+        memcpy(dst, p, first * sizeof(type));                                   \
+        memcpy(dst + first, r->buf, (n - first) * sizeof(type));                \
+        name##_consume(r, n);                                                   \
+        return n;                                                               \
+    }                                                                           \
+    /* Vários produtores: o push sob o spin lock */                             \
+    static inline bool name##_push_mp(name##_t *r, spin_lock_t *lock, type x) { \
+        uint32_t irq = spin_lock_blocking(lock);                                \
+        bool ok = name##_push(r, x);                                            \
+        spin_unlock(lock, irq);                                                 \
+        return ok;                                                              \
+    }
+
+#ifdef __cplusplus
+
+template <typename T, uint32_t N>
+class Ring {
+    static_assert(RING_IS_POW2(N), "Ring: capacidade deve ser potência de 2");
+    static constexpr uint32_t MASK = N - 1;
+
+    T buf_[N];
+    volatile uint32_t head_ = 0;
+    volatile uint32_t tail_ = 0;
+
+public:
+    static constexpr uint32_t capacity() { return N; }
+    uint32_t count() const { return head_ - tail_; }
+    uint32_t space() const { return N - (head_ - tail_); }
+
+    bool push(const T &x) {
+        uint32_t h = head_;
+        if (h - tail_ == N) return false;
+        buf_[h & MASK] = x;
+        __dmb();
+        head_ = h + 1;
+        return true;
+    }
+
+    bool pop(T &x) {
+        uint32_t t = tail_;
+        if (head_ == t) return false;
+        __dmb();
+        x = buf_[t & MASK];
+        __dmb();
+        tail_ = t + 1;
+        return true;
+    }
+
+    const T &peek(uint32_t age) const { return buf_[(head_ - 1 - age) & MASK]; }
+
+    uint32_t write_span(T *&p) {
+        uint32_t pos = head_ & MASK;
+        p = &buf_[pos];
+        return ring_span(pos, N, space());
+    }
+
+    void commit(uint32_t n) {
+        __dmb();
+        head_ += n;
+    }
+
+    uint32_t read_span(T *&p) {
+        uint32_t pos = tail_ & MASK;
+        uint32_t n = ring_span(pos, N, count());
+        __dmb();
+        p = &buf_[pos];
+        return n;
+    }
+
+    void consume(uint32_t n) {
+        __dmb();
+        tail_ += n;
+    }
+
+    bool push_n(const T *src, uint32_t n) {
+        if (space() < n) return false;
+        T *p;
+        uint32_t first = write_span(p);
+        if (first > n) first = n;
+        for (uint32_t i = 0; i < first; i++) p[i] = src[i];
+        for (uint32_t i = first; i < n; i++) buf_[i - first] = src[i];
+        commit(n);
+        return true;
+    }
+
+    uint32_t pop_n(T *dst, uint32_t n) {
+        if (n > count()) n = count();
+        T *p;
+        uint32_t first = read_span(p);
+        if (first > n) first = n;
+        for (uint32_t i = 0; i < first; i++) dst[i] = p[i];
+        for (uint32_t i = first; i < n; i++) dst[i] = buf_[i - first];
+        consume(n);
+        return n;
+    }
+
+    bool push_mp(spin_lock_t *lock, const T &x) {
+        uint32_t irq = spin_lock_blocking(lock);
+        bool ok = push(x);
+        spin_unlock(lock, irq);
+        return ok;
+    }
+};
+
+#endif
+
+#endif
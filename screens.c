@@ -0,0 +1,340 @@
+/**
+ * Gerenciador de telas
+ *
+ * Telas disponíveis (rotação pelo botão ou pelo timer):
+ *   STATUS  - tensão e temperatura em dígitos grandes
+ *   MIN/MAX - mínima, máxima e média desde o boot
+ *   TENDÊNCIA - gráfico das últimas 2 horas e taxa em °C/h
+ *   PREVISÃO - tempo até 55°C (aquecendo) ou 40°C (esfriando), com ± 2σ
+ *   FASE - fase da compostagem, tempo nela, horas acima de 55°C e pico
+ *   ALARMES - alarmes ativos
+ *   DIAGNÓSTICO - bateria, código do ADC e estado do sensor, amostras e
+ *                 tempo ligado
+ *   BARRAMENTO - latência máxima por dispositivo e estatísticas do display
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "ssd1306.h"
+#include "blit.h"
+#include "icons.h"
+#include "bigfont.h"
+#include "screen_templates.h"
+#include "screens.h"
+#include "alarms.h"
+#include "history.h"
+#include "predict.h"
+#include "phase.h"
+#include "diag.h"
+#include "i2c_bus.h"
+#include "supply.h"
+#include "app.h"
+
+typedef struct {
+    const uint8_t *tpl;                         // Parte estática (screens.layout)
+    uint32_t deps;                              // Dados exibidos pela tela
+    void (*draw)(uint8_t *buf, bool full);      // Desenha os campos dinâmicos
+} screen_t;
+
+static volatile uint32_t pending = 0;   // Dados alterados desde o último desenho
+static screen_id_t active = SCREEN_STATUS;
+static bool full_redraw = true;         // Próximo desenho parte do template
+
+static uint8_t frame[SSD1306_BUF_LEN] __aligned(4);
+
+
+/* FUNÇÕES AUXILIARES DE DESENHO */
+
+// Aguarda a cópia do template iniciada por screens_update(). As telas
+// formatam seus valores antes de chamar, para sobrepor a formatação à cópia
+static void template_wait(bool full) {
+    if (full) {
+        fb_copy_dma_wait();
+        ssd1306_mark_all_dirty();
+    }
+}
+
+// Escreve texto e marca como alteradas apenas as colunas que mudaram
+static void put_text(uint8_t *buf, int16_t x, int16_t y, const char *str) {
+    for (; *str && x <= SSD1306_WIDTH - 8; str++, x += 8) {
+        uint8_t *dst = buf + (y / 8) * SSD1306_WIDTH + x;
+        uint8_t before[8];
+        memcpy(before, dst, 8);
+        WriteChar(buf, x, y, *str);
+        if (memcmp(before, dst, 8) != 0) ssd1306_mark_dirty(x, x + 7, y / 8, y / 8);
+    }
+}
+
+static float display_temp(float celsius) {
+    return show_fahrenheit ? celsius_to_fahrenheit(celsius) : celsius;
+}
+
+static char unit_char(void) {
+    return show_fahrenheit ? 'F' : 'C';
+}
+
+
+/* TELAS */
+
+static bigfont_field_t temp_field = { .x_right = 96, .page = 1 };
+static bool last_alarm_icon = false;
+static int last_battery_level = -1;     // Colunas preenchidas (-1 = sem ícone)
+
+// Ícone de bateria com preenchimento proporcional à carga (só na bateria)
+static void draw_battery_icon(uint8_t *buf, bool full) {
+    int level = -1;
+    if (supply.on_battery) {
+        float f = (supply.vsys - SUPPLY_EMPTY_V) / (SUPPLY_FULL_V - SUPPLY_EMPTY_V);
+        level = f <= 0.0f ? 0 : f >= 1.0f ? 5 : (int)(f * 5.0f + 0.5f);
+    }
+    if (!full && level == last_battery_level) return;
+
+    uint8_t *dst = buf + 3 * SSD1306_WIDTH + 120;
+    if (level < 0) {
+        memset(dst, 0, 8);
+    } else {
+        blit(buf, 120, 24, &icon_battery, BLIT_COPY);
+        for (int c = 1; c <= level; c++) dst[c] |= 0x3c;
+    }
+    ssd1306_mark_dirty(120, 127, 3, 3);
+    last_battery_level = level;
+}
+
+static void draw_status(uint8_t *buf, bool full) {
+    char voltage_str[16];
+    char temp_str[16];
+    sprintf(voltage_str, "%.3f V", voltage);
+    if (diag_fault()) strcpy(temp_str, "---.-"); // Sensor com falha
+    else sprintf(temp_str, "%.1f", display_temp(filtered_temp));
+
+    template_wait(full);
+    if (full) {
+        bigfont_field_reset(&temp_field);
+        bigfont_draw_string(buf, 98, 1, show_fahrenheit ? "oF" : "oC");
+    }
+    put_text(buf, 70, 0, voltage_str);
+    bigfont_field_update(&temp_field, buf, temp_str);
+
+    bool alarm = active_alarms != 0;
+    if (full || alarm != last_alarm_icon) {
+        if (alarm) blit(buf, 120, 8, &icon_alarm, BLIT_COPY);
+        else memset(buf + SSD1306_WIDTH + 120, 0, 8);
+        ssd1306_mark_dirty(120, 127, 1, 1);
+        last_alarm_icon = alarm;
+    }
+    draw_battery_icon(buf, full);
+}
+
+static void draw_minmax(uint8_t *buf, bool full) {
+    char min_str[16], max_str[16], mean_str[16];
+    if (history.count == 0) {
+        strcpy(min_str, "  --"), strcpy(max_str, "  --"), strcpy(mean_str, "  --");
+    } else {
+        sprintf(min_str, "%6.1f %c", display_temp(history.min), unit_char());
+        sprintf(max_str, "%6.1f %c", display_temp(history.max), unit_char());
+        sprintf(mean_str, "%6.1f %c", display_temp(history.mean), unit_char());
+    }
+
+    template_wait(full);
+    put_text(buf, 40, 8, min_str);
+    put_text(buf, 40, 16, max_str);
+    put_text(buf, 40, 24, mean_str);
+}
+
+static void draw_trend(uint8_t *buf, bool full) {
+    // Escala vertical automática, com faixa mínima de 2°C
+    int n = history_trend_len();
+    int16_t lo = INT16_MAX, hi = INT16_MIN;
+    for (int i = 0; i < n; i++) {
+        int16_t v = history_trend_point(i);
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+    if (hi - lo < 200) {
+        int16_t mid = (hi + lo) / 2;
+        lo = mid - 100;
+        hi = mid + 100;
+    }
+
+    // Taxa em °C/h (ou °F/h) entre o ponto mais recente e o de 1 hora atrás
+    char rate_str[16] = "   --  ";
+    if (n > 1) {
+        int age = n > 60 ? 60 : n - 1;
+        float rate = (history_trend_point(0) - history_trend_point(age)) / 100.0f * 60.0f / age;
+        if (show_fahrenheit) rate *= 9.0f / 5.0f;
+        sprintf(rate_str, "%+5.1f/H", rate);
+    }
+
+    template_wait(full);
+    put_text(buf, 72, 0, rate_str);
+
+    // Gráfico nas páginas 1 a 3 (24 linhas), ponto mais recente à direita
+    uint8_t *graph = buf + SSD1306_WIDTH;
+    memset(graph, 0, 3 * SSD1306_WIDTH);
+    for (int i = 0; i < n && i < SSD1306_WIDTH - 8; i++) {
+        int x = SSD1306_WIDTH - 1 - i;
+        int row = 23 - (history_trend_point(i) - lo) * 23 / (hi - lo);
+        graph[(row / 8) * SSD1306_WIDTH + x] |= 1u << (row % 8);
+    }
+    ssd1306_mark_dirty(0, SSD1306_WIDTH - 1, 1, 3);
+}
+
+// Horas com uma casa até 10 h, inteiras até 99 h
+static void format_hours(char *str, float h) {
+    if (h < 9.95f) sprintf(str, "%4.1fH", h);
+    else if (h < PREDICT_MAX_H) sprintf(str, "%4dH", (int)(h + 0.5f));
+    else strcpy(str, " >99H");
+}
+
+static void draw_predict(uint8_t *buf, bool full) {
+    char rate_str[16] = "   --  ", target_str[16] = "  --    ", eta_str[16] = "  -- ", ci_str[16] = "  -- ";
+    if (predict.valid) {
+        float rate = show_fahrenheit ? predict.rate * 9.0f / 5.0f : predict.rate;
+        sprintf(rate_str, "%+5.1f/H", rate);
+    }
+    if (predict.target != 0.0f) {
+        sprintf(target_str, "%4.0f %c %c", display_temp(predict.target), unit_char(),
+                predict.rate > 0.0f ? '+' : '-');
+        format_hours(eta_str, predict.eta_h);
+        format_hours(ci_str, predict.ci_h);
+    }
+
+    template_wait(full);
+    put_text(buf, 72, 0, rate_str);
+    put_text(buf, 48, 8, target_str);
+    put_text(buf, 48, 16, eta_str);
+    put_text(buf, 48, 24, ci_str);
+}
+
+// Duração em horas (ou dias, acima de 99 h)
+static void format_duration(char *str, uint32_t s) {
+    float h = s / 3600.0f;
+    if (h < PREDICT_MAX_H) format_hours(str, h);
+    else sprintf(str, "%4luD", (unsigned long)(s / 86400));
+}
+
+static void draw_phase(uint8_t *buf, bool full) {
+    char name_str[16], time_str[16], kill_str[16], peak_str[16];
+    sprintf(name_str, "%-11s", phase_name(phase.phase));
+    format_duration(time_str, phase.phase_s);
+    format_duration(kill_str, phase.kill_s);
+    strcat(kill_str, phase.kill_s >= PHASE_KILL_H * 3600 ? " OK" : "   ");
+    if (phase.peak == INT16_MIN) strcpy(peak_str, "  --    ");
+    else sprintf(peak_str, "%6.1f %c", display_temp(phase.peak / 100.0f), unit_char());
+
+    template_wait(full);
+    put_text(buf, 40, 0, name_str);
+    put_text(buf, 72, 8, time_str);
+    put_text(buf, 48, 16, kill_str);
+    put_text(buf, 40, 24, peak_str);
+}
+
+static void draw_alarms(uint8_t *buf, bool full) {
+    template_wait(full);
+
+    int line = 1;
+    for (uint32_t bit = 1; bit && line < 4; bit <<= 1) {
+        if (active_alarms & bit) {
+            char str[17];
+            snprintf(str, sizeof(str), "%-16s", alarm_name(bit));
+            put_text(buf, 0, line++ * 8, str);
+        }
+    }
+    if (line == 1) put_text(buf, 0, line++ * 8, "NENHUM          ");
+    while (line < 4) put_text(buf, 0, line++ * 8, "                ");
+}
+
+static void draw_diag(uint8_t *buf, bool full) {
+    char bat_str[16], runtime_str[8], adc_str[16], samples_str[16], uptime_str[16];
+    uint32_t s = to_ms_since_boot(get_absolute_time()) / 1000;
+
+    // Tempo restante de bateria em horas (ou dias, acima de 99 h)
+    if (!supply.on_battery) strcpy(runtime_str, "USB");
+    else if (supply.runtime_h < 0.0f) strcpy(runtime_str, "--");
+    else if (supply.runtime_h < 99.5f) snprintf(runtime_str, sizeof(runtime_str), "%dH", (int)(supply.runtime_h + 0.5f));
+    else snprintf(runtime_str, sizeof(runtime_str), "%dD", (int)(supply.runtime_h / 24.0f + 0.5f)); // Até 99D (supply.c)
+    sprintf(bat_str, "%5.2fV %5s", supply.vsys, runtime_str);
+    sprintf(adc_str, "%7lu%s", (unsigned long)adc_raw, diag_name(diag.fault));
+    sprintf(samples_str, "%7lu", (unsigned long)sample_count);
+    sprintf(uptime_str, "%4lu:%02lu", (unsigned long)(s / 3600), (unsigned long)(s / 60 % 60));
+
+    template_wait(full);
+    put_text(buf, 32, 0, bat_str);
+    put_text(buf, 40, 8, adc_str);
+    put_text(buf, 72, 16, samples_str);
+    put_text(buf, 72, 24, uptime_str);
+}
+
+static void draw_bus(uint8_t *buf, bool full) {
+    char lat_str[16], frames_str[16], bytes_str[16], errors_str[16];
+    // Latência máxima (fila até o STOP) em ms: display e sensor
+    snprintf(lat_str, sizeof(lat_str), "D%4.1f S%4.1f",
+             i2c_bus_stats[I2C_DEV_DISPLAY].lat_max_us / 1000.0f,
+             i2c_bus_stats[I2C_DEV_SENSOR].lat_max_us / 1000.0f);
+    sprintf(frames_str, "%7lu", (unsigned long)ssd1306_stats.frames);
+    sprintf(bytes_str, "%7lu", (unsigned long)ssd1306_stats.bytes);
+    sprintf(errors_str, "%7lu", (unsigned long)ssd1306_stats.errors);
+
+    template_wait(full);
+    put_text(buf, 40, 0, lat_str);
+    put_text(buf, 72, 8, frames_str);
+    put_text(buf, 72, 16, bytes_str);
+    put_text(buf, 72, 24, errors_str);
+}
+
+static const screen_t screens[SCREEN_COUNT] = {
+    [SCREEN_STATUS] = { screen_template_status, DATA_TEMP | DATA_UNIT | DATA_ALARM | DATA_SUPPLY, draw_status },
+    [SCREEN_MINMAX] = { screen_template_minmax, DATA_MINMAX | DATA_UNIT, draw_minmax },
+    [SCREEN_TREND]  = { screen_template_trend, DATA_TREND | DATA_UNIT, draw_trend },
+    [SCREEN_PREDICT] = { screen_template_predict, DATA_PREDICT | DATA_UNIT, draw_predict },
+    [SCREEN_PHASE]  = { screen_template_phase, DATA_PHASE | DATA_UNIT, draw_phase },
+    [SCREEN_ALARMS] = { screen_template_alarms, DATA_ALARM, draw_alarms },
+    [SCREEN_DIAG]   = { screen_template_diag, DATA_DIAG | DATA_SUPPLY, draw_diag },
+    [SCREEN_BUS]    = { screen_template_bus, DATA_BUS, draw_bus },
+};
+
+
+/* GERENCIADOR */
+
+// Pode ser chamada das interrupções: apenas acumula a máscara
+void screens_notify(uint32_t data) {
+    uint32_t irq = save_and_disable_interrupts();
+    pending |= data;
+    restore_interrupts(irq);
+}
+
+void screens_show(screen_id_t id) {
+    if (id >= SCREEN_COUNT) id = SCREEN_STATUS;
+    active = id;
+    full_redraw = true;
+}
+
+void screens_next(void) {
+    screens_show((active + 1) % SCREEN_COUNT);
+}
+
+screen_id_t screens_active(void) {
+    return active;
+}
+
+// Chamada pelo loop principal: desenha a tela ativa se algo dela mudou
+void screens_update(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t changed = pending;
+    pending = 0;
+    restore_interrupts(irq);
+
+    const screen_t *s = &screens[active];
+    bool full = full_redraw || (changed & s->deps & DATA_UNIT);
+    if (!full && !(changed & s->deps)) return;
+
+    // O quadro anterior ainda pode estar saindo pelo I2C a partir do framebuffer
+    ssd1306_wait_idle();
+    if (full) fb_copy_dma_start(frame, s->tpl, SSD1306_BUF_LEN);
+    s->draw(frame, full);
+    full_redraw = false;
+
+    render_dirty(frame);
+}
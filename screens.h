@@ -0,0 +1,47 @@
+/**
+ * Gerenciador de telas
+ *
+ * Cada tela declara de quais dados depende (máscara DATA_*). Os produtores
+ * (timer do ADC, alarmes, histórico) apenas avisam o que mudou com
+ * screens_notify(); só a tela ativa formata e desenha, e somente quando um
+ * dado do qual ela depende mudou. Telas ocultas não custam nada: ao se
+ * tornarem visíveis são redesenhadas por completo a partir do template.
+ */
+
+#ifndef SCREENS_H
+#define SCREENS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Dados dos quais as telas podem depender
+#define DATA_TEMP    (1u << 0)  // Tensão e temperatura filtrada
+#define DATA_UNIT    (1u << 1)  // Unidade de exibição (°C/°F)
+#define DATA_MINMAX  (1u << 2)  // Mínimo/máximo
+#define DATA_TREND   (1u << 3)  // Novo ponto de tendência
+#define DATA_ALARM   (1u << 4)  // Conjunto de alarmes ativos
+#define DATA_DIAG    (1u << 5)  // Contadores de diagnóstico
+#define DATA_BUS     (1u << 6)  // Estatísticas do barramento I2C
+#define DATA_SUPPLY  (1u << 7)  // Tensão da bateria e tempo restante
+#define DATA_PREDICT (1u << 8)  // Previsão do tempo até os limiares
+#define DATA_PHASE   (1u << 9)  // Fase da compostagem e permanências
+
+typedef enum {
+    SCREEN_STATUS,
+    SCREEN_MINMAX,
+    SCREEN_TREND,
+    SCREEN_PREDICT,
+    SCREEN_PHASE,
+    SCREEN_ALARMS,
+    SCREEN_DIAG,
+    SCREEN_BUS,
+    SCREEN_COUNT
+} screen_id_t;
+
+void screens_notify(uint32_t data);
+void screens_show(screen_id_t id);
+void screens_next(void);
+screen_id_t screens_active(void);
+void screens_update(void);
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * Fonte de 7 segmentos com 16 pixels de altura (gerada por
+ * tools/gen_seg7_font.py - não editar).
+ *
+ * Cada glifo é guardado como tiras de colunas por página: primeiro as
+ * colunas da página de cima, depois as da página de baixo. A largura já
+ * inclui as colunas de espaçamento. 'o' é o símbolo de grau.
+ */
+
+#ifndef SEG7_FONT_H
+#define SEG7_FONT_H
+
+#include <stdint.h>
+
+#define SEG7_HEIGHT 16
+#define SEG7_PAGES  2
+
+static const char seg7_chars[] = "0123456789-CF .o";
+
+static const uint8_t seg7_width[] = { 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 5, 7 };
+static const uint16_t seg7_offset[] = { 0, 24, 48, 72, 96, 120, 144, 168, 192, 216, 240, 264, 288, 312, 336, 346 };
+
+static const uint8_t seg7_strips[] = {
+    0xfe, 0xff, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xff, 0xfe, 0x00, 0x00, 0x7f, 0xff, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xff, 0x7f, 0x00, 0x00, // 0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x7f, 0x00, 0x00, // 1
+    0x00, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0xff, 0xfe, 0x00, 0x00, 0x7f, 0xff, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0x00, 0x00, 0x00, // 2
+    0x00, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0xff, 0xfe, 0x00, 0x00, 0x00, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xff, 0x7f, 0x00, 0x00, // 3
+    0xfe, 0xfe, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xfe, 0xfe, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x7f, 0x7f, 0x00, 0x00, // 4
+    0xfe, 0xff, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x00, 0x00, 0x00, 0x00, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xff, 0x7f, 0x00, 0x00, // 5
+    0xfe, 0xff, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xff, 0x7f, 0x00, 0x00, // 6
+    0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xff, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x7f, 0x00, 0x00, // 7
+    0xfe, 0xff, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0xff, 0xfe, 0x00, 0x00, 0x7f, 0xff, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xff, 0x7f, 0x00, 0x00, // 8
+    0xfe, 0xff, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0xff, 0xfe, 0x00, 0x00, 0x00, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xc1, 0xff, 0x7f, 0x00, 0x00, // 9
+    0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, // -
+    0xfe, 0xff, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0x00, 0x00, 0x00, // C
+    0xfe, 0xff, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x00, 0x00, 0x00, 0x7f, 0x7f, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, // F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, //  
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xc0, 0xc0, 0x00, 0x00, // .
+    0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // o
+};
+
+#endif
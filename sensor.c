@@ -0,0 +1,43 @@
+/**
+ * Tipos de sensor: diodo (lei linear) e NTC (tabela de Steinhart-Hart)
+ */
+
+#include "supply.h"
+#include "sensor.h"
+#include "lerp.h"
+#include "ntc_lut.h"    // Gerado por tools/gen_ntc_lut.py
+
+// Lei do diodo: tensão para temperatura em Celsius
+static float diode_to_celsius(const acq_sample_t *sample, const acq_backend_t *acq) {
+    // Compensa a corrente do diodo quando R1 está ligado ao VSYS (bateria)
+    float v = supply_compensate(sample->voltage);
+    return (v - 0.6264f) / (-0.0021f);
+}
+
+// Interpolação linear entre os 257 pontos da tabela (índice = 8 bits altos),
+// feita pelo interpolador do SIO
+int32_t ntc_centi_celsius(uint32_t ratio16) {
+    return lerp_lut16(ntc_lut, ratio16);
+}
+
+// Backends referenciados ao 3V3 (o mesmo do divisor) usam o código direto,
+// que já é a razão do divisor; os demais passam pela tensão medida
+static float ntc_to_celsius(const acq_sample_t *sample, const acq_backend_t *acq) {
+    uint32_t ratio16;
+    if (acq->ratiometric) {
+        ratio16 = acq->bits <= 16 ? sample->code << (16 - acq->bits) : sample->code >> (acq->bits - 16);
+    } else {
+        ratio16 = sample->voltage > 0.0f ? (uint32_t)(sample->voltage * (65536.0f / ADC_VREF)) : 0;
+    }
+    return ntc_centi_celsius(ratio16) * 0.01f;
+}
+
+const sensor_type_t sensor_diode = {
+    .name = "DIODO",
+    .to_celsius = diode_to_celsius,
+};
+
+const sensor_type_t sensor_ntc = {
+    .name = "NTC",
+    .to_celsius = ntc_to_celsius,
+};
@@ -0,0 +1,29 @@
+/**
+ * Tipos de sensor ligados ao canal analógico
+ *
+ * Convertem a amostra do backend de aquisição em temperatura. O tipo é
+ * escolhido na compilação (-DSENSOR_TYPE=diode|ntc):
+ *  - diode: lei linear do diodo, com a compensação da corrente pelo VSYS;
+ *  - ntc: termistor em divisor com resistor série; a curva de
+ *    Steinhart-Hart é tabelada na compilação (tools/gen_ntc_lut.py) e
+ *    interpolada em ponto fixo, sem log() por amostra.
+ * Os backends que já entregam °C (celsius = true) não passam por aqui.
+ */
+
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include "acq.h"
+
+typedef struct {
+    const char *name;
+    float (*to_celsius)(const acq_sample_t *sample, const acq_backend_t *acq);
+} sensor_type_t;
+
+extern const sensor_type_t sensor_diode;   // Diodo de silício (padrão)
+extern const sensor_type_t sensor_ntc;     // NTC 10k em divisor (ntc_lut.h)
+
+// Conversão do NTC a partir da razão do divisor em 16 bits (0-65535)
+int32_t ntc_centi_celsius(uint32_t ratio16);
+
+#endif
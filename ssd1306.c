@@ -0,0 +1,204 @@
+/**
+ * Driver do display OLED SSD1306 (128x32, I2C)
+ *
+ * Funções dadas pelo próprio exemplo da Adafruit/Raspberry Pi, separadas do
+ * main.c para serem usadas também pelo blit de bitmaps. Os envios passam
+ * pelo gerenciador do barramento (i2c_bus.c) com prioridade baixa.
+ */
+
+#include <string.h>
+#include <ctype.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+#include "ssd1306.h"
+#include "ssd1306_font.h"
+
+ssd1306_stats_t ssd1306_stats;
+
+// Colunas alteradas desde o último envio, por página: [start, end)
+static uint8_t dirty_start[SSD1306_NUM_PAGES];
+static uint8_t dirty_end[SSD1306_NUM_PAGES];
+
+void calc_render_area_buflen(struct render_area *area) {
+    area->buflen = (area->end_col - area->start_col + 1) * (area->end_page - area->start_page + 1);
+}
+
+// Transações do display: um comando de área e uma página de dados por área
+static i2c_txn_t cmd_txn;
+static i2c_txn_t area_txn[SSD1306_NUM_PAGES];
+static uint8_t area_cmds[SSD1306_NUM_PAGES][6];
+static i2c_txn_t page_txn[SSD1306_NUM_PAGES];
+
+// Contabiliza uma transação concluída para a tela de barramento
+static void count_write(i2c_txn_t *txn, bool ok) {
+    ssd1306_stats.bytes += txn->tx_len + (txn->prefix >= 0);
+    if (!ok) ssd1306_stats.errors++;
+}
+
+static void display_txn(i2c_txn_t *txn, uint8_t prefix, const uint8_t *buf, int len) {
+    *txn = (i2c_txn_t){
+        .addr = SSD1306_I2C_ADDR,
+        .prio = I2C_PRIO_LOW,
+        .dev = I2C_DEV_DISPLAY,
+        .prefix = prefix,
+        .tx = buf,
+        .tx_len = len,
+        .done = count_write,
+    };
+}
+
+// Aguarda o envio anterior: o framebuffer e as transações ficam livres
+void ssd1306_wait_idle(void) {
+    for (int i = 0; i < (int)SSD1306_NUM_PAGES; i++) {
+        while (area_txn[i].busy || page_txn[i].busy) tight_loop_contents();
+    }
+    while (cmd_txn.busy) tight_loop_contents();
+}
+
+void SSD1306_send_cmd(uint8_t cmd) {
+    ssd1306_wait_idle();
+    display_txn(&cmd_txn, 0x80, &cmd, 1);
+    i2c_bus_transfer_blocking(&cmd_txn);
+}
+
+// Lista de comandos numa única transação (Co = 0: o resto é tudo comando)
+void SSD1306_send_cmd_list(uint8_t *buf, int num) {
+    ssd1306_wait_idle();
+    display_txn(&cmd_txn, 0x00, buf, num);
+    i2c_bus_transfer_blocking(&cmd_txn);
+}
+
+// Dados em blocos de uma página, sem cópia: o byte de controle 0x40 vai
+// como prefixo da transação
+void SSD1306_send_buf(uint8_t buf[], int buflen) {
+    ssd1306_wait_idle();
+    for (int i = 0; buflen > 0 && i < (int)SSD1306_NUM_PAGES; i++) {
+        int len = buflen < SSD1306_WIDTH ? buflen : SSD1306_WIDTH;
+        display_txn(&page_txn[i], 0x40, buf, len);
+        i2c_bus_submit(&page_txn[i]);
+        buf += len;
+        buflen -= len;
+    }
+    ssd1306_wait_idle();
+}
+
+void SSD1306_init() {
+    uint8_t cmds[] = {
+        0xAE,       // SET_DISP: display off
+        0x20, 0x00, // SET_MEM_MODE: horizontal addressing
+        0x40,       // SET_DISP_START_LINE: start line 0
+        0xA1,       // SET_SEG_REMAP: column 127 mapped to SEG0
+        0xA8, 0x1F, // SET_MUX_RATIO: height-1 (31 for 32px display)
+        0xC8,       // SET_COM_OUT_DIR: scan from COM[N-1] to COM0
+        0xD3, 0x00, // SET_DISP_OFFSET: no offset
+        0xDA, 0x02, // SET_COM_PIN_CFG: sequential, disable COM left/right remap (32px height)
+        0xD5, 0x80, // SET_DISP_CLK_DIV: div ratio 1, standard freq
+        0xD9, 0xF1, // SET_PRECHARGE: Vcc internally generated
+        0xDB, 0x30, // SET_VCOM_DESEL: 0.83xVcc
+        0x81, 0xFF, // SET_CONTRAST: max contrast
+        0xA4,       // SET_ENTIRE_ON: output follows RAM content
+        0xA6,       // SET_NORM_DISP: normal display (not inverted)
+        0x8D, 0x14, // SET_CHARGE_PUMP: enable, Vcc internally generated
+        0xAF        // SET_DISP: display on
+    };
+
+    SSD1306_send_cmd_list(cmds, sizeof(cmds)/sizeof(cmds[0]));
+}
+
+static inline int GetFontIndex(uint8_t ch) {
+    static const char punct[] = ".-:/%+"; // Glifos após o '9', na ordem da fonte
+    if (ch >= 'A' && ch <='Z') return ch - 'A' + 1;
+    else if (ch >= '0' && ch <='9') return ch - '0' + 27;
+    for (int i = 0; punct[i]; i++) {
+        if (ch == punct[i]) return 37 + i;
+    }
+    return 0; // Space for unsupported characters
+}
+
+void WriteChar(uint8_t *buf, int16_t x, int16_t y, uint8_t ch) {
+    if (x > SSD1306_WIDTH - 8 || y > SSD1306_HEIGHT - 8) return;
+    y = y/8;
+    ch = toupper(ch);
+    int idx = GetFontIndex(ch);
+    int fb_idx = y * 128 + x;
+    for (int i=0; i<8; i++) buf[fb_idx++] = font[idx * 8 + i];
+}
+
+void WriteString(uint8_t *buf, int16_t x, int16_t y, char *str) {
+    if (x > SSD1306_WIDTH - 8 || y > SSD1306_HEIGHT - 8) return;
+    while (*str) WriteChar(buf, x, y, *str++), x+=8;
+}
+
+void render(uint8_t *buf, struct render_area *area) {
+    uint8_t cmds[] = {
+        0x21, area->start_col, area->end_col, // SET_COL_ADDR
+        0x22, area->start_page, area->end_page // SET_PAGE_ADDR
+    };
+    SSD1306_send_cmd_list(cmds, sizeof(cmds)/sizeof(cmds[0]));
+    SSD1306_send_buf(buf, area->buflen);
+    ssd1306_stats.frames++;
+}
+
+// Contraste menor reduz a corrente do painel (modo de bateria fraca)
+void ssd1306_set_contrast(uint8_t level) {
+    uint8_t cmds[] = { 0x81, level }; // SET_CONTRAST
+    SSD1306_send_cmd_list(cmds, sizeof(cmds)/sizeof(cmds[0]));
+}
+
+void ssd1306_mark_dirty(int16_t col0, int16_t col1, uint8_t page0, uint8_t page1) {
+    if (col0 < 0) col0 = 0;
+    if (col1 > SSD1306_WIDTH - 1) col1 = SSD1306_WIDTH - 1;
+    if (col0 > col1) return;
+
+    for (uint8_t p = page0; p <= page1 && p < SSD1306_NUM_PAGES; p++) {
+        if (dirty_start[p] >= dirty_end[p]) {
+            dirty_start[p] = col0;
+            dirty_end[p] = col1 + 1;
+        } else {
+            if (col0 < dirty_start[p]) dirty_start[p] = col0;
+            if (col1 + 1 > dirty_end[p]) dirty_end[p] = col1 + 1;
+        }
+    }
+}
+
+void ssd1306_mark_all_dirty(void) {
+    ssd1306_mark_dirty(0, SSD1306_WIDTH - 1, 0, SSD1306_NUM_PAGES - 1);
+}
+
+// Não bloqueia: enfileira no barramento a área de cada grupo de páginas e
+// uma transação por página, apontando direto para o framebuffer. O
+// framebuffer não pode mudar até ssd1306_wait_idle() retornar.
+void render_dirty(uint8_t *buf) {
+    ssd1306_wait_idle();
+    uint8_t p = 0, n = 0;
+
+    while (p < SSD1306_NUM_PAGES) {
+        uint8_t start = dirty_start[p], end = dirty_end[p];
+        if (start >= end) {
+            p++;
+            continue;
+        }
+
+        // Páginas seguidas com o mesmo intervalo de colunas viram uma única
+        // área; o display avança para a página seguinte sozinho
+        uint8_t q = p;
+        while (q + 1 < (int)SSD1306_NUM_PAGES && dirty_start[q + 1] == start && dirty_end[q + 1] == end) q++;
+
+        uint8_t *cmds = area_cmds[n];
+        cmds[0] = 0x21, cmds[1] = start, cmds[2] = end - 1;    // SET_COL_ADDR
+        cmds[3] = 0x22, cmds[4] = p, cmds[5] = q;              // SET_PAGE_ADDR
+        display_txn(&area_txn[n], 0x00, cmds, 6);
+        i2c_bus_submit(&area_txn[n]);
+        n++;
+
+        // Uma transação por página: leituras de sensores passam entre elas
+        for (uint8_t k = p; k <= q; k++) {
+            display_txn(&page_txn[k], 0x40, buf + k * SSD1306_WIDTH + start, end - start);
+            i2c_bus_submit(&page_txn[k]);
+            dirty_start[k] = dirty_end[k] = 0;
+        }
+        ssd1306_stats.frames++;
+        p = q + 1;
+    }
+}
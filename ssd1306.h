@@ -0,0 +1,61 @@
+/**
+ * Driver do display OLED SSD1306 (128x32, I2C)
+ *
+ * Baseado no exemplo da Adafruit/Raspberry Pi. O framebuffer é organizado
+ * em páginas: cada byte representa 8 pixels verticais de uma coluna.
+ */
+
+#ifndef SSD1306_H
+#define SSD1306_H
+
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+// Configurações do display OLED (dadas pelo próprio exemplo da Adafruit)
+#define SSD1306_HEIGHT      32      // Altura do display em pixels
+#define SSD1306_WIDTH       128     // Largura do display em pixels
+#define SSD1306_I2C_ADDR    _u(0x3C) // Endereço I2C do display
+#define SSD1306_I2C_CLK     400     // Clock I2C em kHz (padrão)
+#define SSD1306_PAGE_HEIGHT _u(8)   // Altura de uma página (padrão)
+#define SSD1306_NUM_PAGES   (SSD1306_HEIGHT / SSD1306_PAGE_HEIGHT)
+#define SSD1306_BUF_LEN     (SSD1306_NUM_PAGES * SSD1306_WIDTH)
+
+// Área de renderização para o display OLED (dado pelo próprio exemplo da Adafruit)
+struct render_area {
+    uint8_t start_col;
+    uint8_t end_col;
+    uint8_t start_page;
+    uint8_t end_page;
+    int buflen;
+};
+
+// Estatísticas do envio ao display (tela de barramento)
+typedef struct {
+    uint32_t frames;    // Áreas enviadas por render()
+    uint32_t bytes;     // Bytes escritos no I2C (com os de controle)
+    uint32_t errors;    // Escritas sem ACK
+} ssd1306_stats_t;
+
+extern ssd1306_stats_t ssd1306_stats;
+
+void calc_render_area_buflen(struct render_area *area);
+void SSD1306_send_cmd(uint8_t cmd);
+void SSD1306_send_cmd_list(uint8_t *buf, int num);
+void SSD1306_send_buf(uint8_t buf[], int buflen);
+void SSD1306_init();
+void render(uint8_t *buf, struct render_area *area);
+void ssd1306_set_contrast(uint8_t level);
+void ssd1306_wait_idle(void);
+
+// Atualização parcial: marca colunas alteradas (intervalos inclusivos) e
+// envia ao display somente essas áreas. render_dirty() não bloqueia: o
+// framebuffer só pode ser alterado depois de ssd1306_wait_idle()
+void ssd1306_mark_dirty(int16_t col0, int16_t col1, uint8_t page0, uint8_t page1);
+void ssd1306_mark_all_dirty(void);
+void render_dirty(uint8_t *buf);
+
+// Texto com a fonte 8x8 (y deve ser múltiplo de 8)
+void WriteChar(uint8_t *buf, int16_t x, int16_t y, uint8_t ch);
+void WriteString(uint8_t *buf, int16_t x, int16_t y, char *str);
+
+#endif
@@ -4,7 +4,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
-// Vertical bitmaps, A-Z, 0-9. Each is 8 pixels high and wide
+// Vertical bitmaps, A-Z, 0-9 and . - : / % +. Each is 8 pixels high and wide
 // These are defined vertically to make them quick to copy to FB
 
 static uint8_t font[] = {
@@ -45,4 +45,10 @@ static uint8_t font[] = {
 0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, //7
 0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, //8
 0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, //9
+0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, //.
+0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, //-
+0x00, 0x00, 0x00, 0x36, 0x36, 0x00, 0x00, 0x00, //:
+0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00, ///
+0x00, 0x23, 0x13, 0x08, 0x64, 0x62, 0x00, 0x00, //%
+0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00, //+
 };
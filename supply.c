@@ -0,0 +1,89 @@
+/**
+ * Monitoramento da alimentação (VSYS) pelo ADC3
+ */
+
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+#include "supply.h"
+#include "alarms.h"
+#include "screens.h"
+#include "lerp.h"
+
+#define VSYS_ALPHA_Q8   16          // Filtro exponencial do VSYS (16/256)
+#define SLOPE_ALPHA     (1.0f / 8)  // Filtro da inclinação (a cada minuto)
+#define SLOPE_PERIOD_MS 60000       // Intervalo entre medidas de inclinação
+
+supply_t supply = { .runtime_h = -1.0f };
+
+static int32_t vsys_uv = 0;             // VSYS filtrado (µV, no interpolador)
+static float slope_ref_v = 0.0f;        // VSYS no início do intervalo
+static uint32_t slope_elapsed_ms = 0;
+static bool slope_valid = false;
+
+void supply_init(void) {
+    adc_gpio_init(VSYS_PIN);
+    gpio_init(VBUS_SENSE_PIN);
+    gpio_set_dir(VBUS_SENSE_PIN, GPIO_IN);
+}
+
+// Chamada a cada rodada do ADC com a tensão no canal 3 e o período atual
+void supply_update(float adc3_v, uint32_t period_ms) {
+    float v = adc3_v * VSYS_DIVIDER;
+    bool on_battery = !gpio_get(VBUS_SENSE_PIN);
+
+    // 1. Filtra o VSYS (a primeira leitura inicializa o filtro)
+    int32_t v_uv = (int32_t)(v * 1e6f);
+    if (vsys_uv == 0) {
+        vsys_uv = v_uv;
+        slope_ref_v = v;
+    } else {
+        vsys_uv = lerp_blend(vsys_uv, v_uv, VSYS_ALPHA_Q8);
+    }
+    supply.vsys = vsys_uv * 1e-6f;
+
+    // 2. Inclinação da descarga, medida a cada minuto
+    if (on_battery != supply.on_battery) {
+        // Troca de fonte: recomeça a estimativa
+        supply.on_battery = on_battery;
+        slope_valid = false;
+        slope_elapsed_ms = 0;
+        slope_ref_v = supply.vsys;
+    }
+    slope_elapsed_ms += period_ms;
+    if (slope_elapsed_ms >= SLOPE_PERIOD_MS) {
+        float s = (supply.vsys - slope_ref_v) * 3600000.0f / slope_elapsed_ms;
+        supply.slope = slope_valid ? supply.slope + (s - supply.slope) * SLOPE_ALPHA : s;
+        slope_valid = true;
+        slope_ref_v = supply.vsys;
+        slope_elapsed_ms = 0;
+    }
+
+    // 3. Tempo restante por extrapolação linear até SUPPLY_EMPTY_V
+    supply.runtime_h = -1.0f;
+    if (on_battery && slope_valid && supply.slope < -SUPPLY_SLOPE_MIN) {
+        float r = (supply.vsys - SUPPLY_EMPTY_V) / -supply.slope;
+        if (r <= SUPPLY_RUNTIME_MAX_H) supply.runtime_h = r > 0.0f ? r : 0.0f;
+    }
+
+    // 4. Modo de bateria fraca, com histerese
+    bool low = supply.low;
+    if (!on_battery || supply.vsys > SUPPLY_OK_V) low = false;
+    else if (supply.vsys < SUPPLY_LOW_V) low = true;
+    if (low != supply.low) {
+        supply.low = low;
+        alarm_set(ALARM_BATTERY_LOW, low);
+    }
+
+    screens_notify(DATA_SUPPLY);
+}
+
+// Corrige a tensão do diodo para a corrente da calibração: com R1 ligado ao
+// VSYS, a corrente cai junto com a bateria e Vf cai n*Vt*ln(I/I_cal). Pelo
+// USB o R1 fica no VBUS (5 V, a tensão da calibração) e não há o que corrigir
+float supply_compensate(float diode_v) {
+    if (!supply.on_battery || supply.vsys <= diode_v) return diode_v;
+    float ratio = (supply.vsys - diode_v) / (SUPPLY_CAL_V - diode_v);
+    return diode_v - DIODE_N_VT * logf(ratio);
+}
@@ -0,0 +1,52 @@
+/**
+ * Monitoramento da alimentação (VSYS) pelo ADC3
+ *
+ * No Pico o GPIO29/ADC3 mede VSYS/3 por um divisor na placa e o GPIO24 indica
+ * se há VBUS (USB). O VSYS é convertido na mesma rodada do round-robin do ADC
+ * que lê o diodo, e alimenta:
+ *  - a compensação da corrente do diodo (só na bateria, com R1 no VSYS;
+ *    pelo USB o R1 fica no VBUS, na tensão da calibração);
+ *  - o modo de bateria fraca, que reduz amostragem, display e LED;
+ *  - a estimativa do tempo restante de bateria (tela de diagnóstico).
+ */
+
+#ifndef SUPPLY_H
+#define SUPPLY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define VSYS_PIN            29      // GPIO 29 (Canal ADC3, VSYS/3)
+#define VSYS_ADC_NUM        3       // Número do canal ADC
+#define VSYS_DIVIDER        3.0f    // Divisor da placa (VSYS/3)
+#define VBUS_SENSE_PIN      24      // Alto quando alimentado pelo USB
+
+// Limiares para um pack de 3 pilhas AA (1,5 V a 1,0 V por pilha)
+#define SUPPLY_FULL_V       4.5f    // Bateria cheia (ícone da tela de status)
+#define SUPPLY_LOW_V        3.6f    // Entra no modo de bateria fraca
+#define SUPPLY_OK_V         3.8f    // Sai do modo (histerese)
+#define SUPPLY_EMPTY_V      3.0f    // Tensão considerada bateria vazia
+#define SUPPLY_CAL_V        5.0f    // Tensão em R1 na calibração do diodo
+#define DIODE_N_VT          0.0488f // n*Vt do 1N4148 (n ~ 1.9, 25°C)
+
+// Tempo restante: com o VSYS quase plano a inclinação filtrada passa perto
+// de zero e a extrapolação explode; abaixo da inclinação mínima ou acima do
+// teto a estimativa fica desconhecida
+#define SUPPLY_SLOPE_MIN    0.0005f // Menor descarga considerada (V/h)
+#define SUPPLY_RUNTIME_MAX_H 2376.0f // 99 dias
+
+typedef struct {
+    float vsys;             // VSYS filtrado (V)
+    float slope;            // Variação do VSYS (V/h), filtrada
+    float runtime_h;        // Tempo restante estimado (h), < 0 = desconhecido
+    bool on_battery;        // Sem VBUS
+    bool low;               // Modo de bateria fraca ativo
+} supply_t;
+
+extern supply_t supply;
+
+void supply_init(void);
+void supply_update(float adc3_v, uint32_t period_ms);
+float supply_compensate(float diode_v);
+
+#endif
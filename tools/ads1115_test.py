@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+"""
+Teste do backend ADS1115 (acq_ads1115.c) contra um modelo do conversor.
+
+Compila acq_ads1115.c com o gerenciador do barramento de tools/host/ e
+tools/host/ads1115_test.c, que liga um modelo dos registradores do ADS1115
+(ponteiro, conversão, configuração 0x4680, limiares no modo RDY e o pulso
+do ALERT/RDY no GP16) ao endereço 0x48 e roda os cenários: inicialização,
+conversão contínua com uma leitura por RDY, média entregue ao timer, loop
+principal lento, saturação e conversor ausente.
+
+Uso:
+    tools/ads1115_test.py [--build-dir DIR]
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+from host_build import ROOT, build
+
+SOURCES = ["tools/host/ads1115_test.c", "tools/host/host.c", "tools/host/i2c_bus.c", "acq_ads1115.c"]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("--build-dir", default=os.path.join(ROOT, "build", "ads1115_test"))
+    args = ap.parse_args()
+    exe = build("ads1115_test", SOURCES, args.build_dir)
+    sys.exit(subprocess.run([exe]).returncode)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Teste do blit.c contra imagens de referência.
+
+Compila blit.c com tools/host/blit_test.c e desenha cada caso (modos COPY,
+OR, AND e XOR, posições alinhadas, deslocadas dentro da página, recortadas
+em cada borda e fora da tela) sobre um framebuffer com listras. O resultado
+é comparado byte a byte com tools/host/golden/blit/<caso>.bin, o
+framebuffer de 512 bytes no formato do SSD1306 (128x32). A versão RLE de cada
+bitmap (tools/rle_encode.py) tem que dar o mesmo framebuffer que a versão
+sem compressão.
+
+Uso:
+    tools/blit_test.py             compara com as referências
+    tools/blit_test.py --update    regrava as referências (conferir o
+                                   desenho com --show antes do commit)
+    tools/blit_test.py --show CASO desenha o caso no terminal
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+from host_build import HOST, ROOT, build
+from rle_encode import rle_encode
+
+SOURCES = ["tools/host/blit_test.c", "blit.c"]
+GOLDEN = os.path.join(HOST, "golden", "blit")
+MODES = ["copy", "or", "and", "xor"]
+WIDTH, PAGES = 128, 4
+
+
+def logo():
+    text = open(os.path.join(ROOT, "raspberry26x32.h"), encoding="utf-8").read()
+    body = text[text.index("{") + 1:text.rindex("}")]
+    return 26, 32, [int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", body)]
+
+
+def odd():
+    """19x13: a última página é parcial, com colunas repetidas para o RLE."""
+    w, h = 19, 13
+    pages = [[0] * w for _ in range((h + 7) // 8)]
+    for x in range(w):
+        for y in range(h):
+            if (x // 4 * 7 + 3 * y) % 5 < 2 or y == h - 1:
+                pages[y // 8][x] |= 1 << (y % 8)
+    return w, h, [b for page in pages for b in page]
+
+
+def full():
+    """Tela inteira: no caminho alinhado vai numa única cópia."""
+    return WIDTH, PAGES * 8, [(x * 37 + p * 11) & 0xFF for p in range(PAGES) for x in range(WIDTH)]
+
+
+PLACEMENTS = {
+    "logo": [(8, 0), (51, 5), (-9, -11), (113, 13), (130, 10), (40, -40)],
+    "odd": [(40, 11), (-5, 23), (120, -6)],
+    "full": [(0, 0), (0, 3), (-64, -12)],
+}
+BITMAPS = {"logo": logo, "odd": odd, "full": full}
+
+
+def cases():
+    """(nome, modo, x, y, largura, altura, rle, bytes)"""
+    for name, placements in PLACEMENTS.items():
+        w, h, data = BITMAPS[name]()
+        for x, y in placements:
+            for mode in range(len(MODES)):
+                case = f"{name}_{MODES[mode]}_{x}_{y}"
+                yield case, mode, x, y, w, h, False, data
+                yield case, mode, x, y, w, h, True, rle_encode(data)
+
+
+def render(exe, all_cases):
+    lines = "".join(f"{m} {x} {y} {w} {h} {int(r)} {bytes(d).hex()}\n"
+                    for _, m, x, y, w, h, r, d in all_cases)
+    proc = subprocess.run([exe], input=lines, capture_output=True, text=True)
+    if proc.returncode:
+        sys.exit(proc.stderr.strip())       # Escrita fora do framebuffer
+    return [bytes.fromhex(s) for s in proc.stdout.split()]
+
+
+def show(fb, ref=None):
+    """Pixels acesos em '#'; com ref, os diferentes em 'X' (a mais) e 'o' (a menos)."""
+    for y in range(PAGES * 8):
+        row = ""
+        for x in range(WIDTH):
+            on = fb[y // 8 * WIDTH + x] >> (y % 8) & 1
+            want = on if ref is None else ref[y // 8 * WIDTH + x] >> (y % 8) & 1
+            row += ("#" if on else ".") if on == want else ("X" if on else "o")
+        print(row)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0],
+                                 formatter_class=argparse.RawDescriptionHelpFormatter,
+                                 epilog=__doc__.split("\n\n", 2)[2])
+    ap.add_argument("--update", action="store_true")
+    ap.add_argument("--show", metavar="CASO")
+    ap.add_argument("--build-dir", default=os.path.join(ROOT, "build", "blit_test"))
+    args = ap.parse_args()
+
+    exe = build("blit_test", SOURCES, args.build_dir)
+    all_cases = list(cases())
+    results = render(exe, all_cases)
+
+    if args.show:
+        fbs = [fb for c, fb in zip(all_cases, results) if c[0] == args.show]
+        if not fbs:
+            sys.exit(f"caso desconhecido: {args.show}")
+        show(fbs[0])
+        return
+
+    if args.update:
+        os.makedirs(GOLDEN, exist_ok=True)
+    errors = 0
+    for (case, mode, x, y, w, h, rle, data), fb in zip(all_cases, results):
+        path = os.path.join(GOLDEN, case + ".bin")
+        if args.update and not rle:
+            with open(path, "wb") as f:
+                f.write(fb)
+        ref = open(path, "rb").read() if os.path.exists(path) else None
+        if fb != ref:
+            errors += 1
+            print(f"{case}{' rle' if rle else ''}: " + ("sem referência" if ref is None else "diferente"))
+            if ref is not None:
+                show(fb, ref)
+    print(f"{len(all_cases)} casos, {errors} falha(s)")
+    if errors:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+Guarda do build contra o heap: falha se malloc/free entrarem no firmware.
+
+Roda depois do link (opção HEAP_GUARD do CMake). O firmware não usa heap:
+a memória sob demanda vem dos pools de pool.h. Se algum símbolo do
+alocador da newlib (ou dos wrappers do pico_malloc) estiver no ELF, lista
+os símbolos e, com o .map do link ao lado do ELF, quem puxou o alocador
+(ex.: uma função da libc que aloca por dentro, como strtod ou o printf da
+newlib com %f).
+
+Também imprime a memória reservada pelos pools (pool_storage_<id>): como
+cada pool só tem blocos de um tamanho, esse é o pior caso do firmware e
+não há fragmentação a somar.
+
+Uso:
+    tools/check_heap.py build/main.elf
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from log_decode import Elf  # noqa: E402
+
+ALLOCATOR = {
+    "malloc", "free", "calloc", "realloc", "memalign", "aligned_alloc", "reallocf",
+    "_malloc_r", "_free_r", "_calloc_r", "_realloc_r", "_memalign_r",
+    "__wrap_malloc", "__wrap_free", "__wrap_calloc", "__wrap_realloc",
+}
+STT_OBJECT, STT_FUNC = 1, 2
+
+
+def map_reasons(path):
+    """Membros de biblioteca puxados por um símbolo do alocador (.map)."""
+    if not os.path.exists(path):
+        return []
+    lines = open(path, errors="replace").read().split("\n\n", 2)
+    if len(lines) < 2 or not lines[0].startswith("Archive member included"):
+        return []
+    out, member = [], None
+    for line in lines[1].splitlines():
+        if not line.startswith(" "):
+            member = line.strip()
+        elif member and "(" in line:
+            ref, sym = line.strip().rsplit("(", 1)
+            if sym.rstrip(")") in ALLOCATOR:
+                out.append(f"{member}\n    puxado por {ref.strip()} ({sym}")
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("elf")
+    args = ap.parse_args()
+
+    syms = Elf(args.elf).symbols()
+    pools = sorted((name[len("pool_storage_"):], size) for name, _, size, typ, _ in syms
+                   if typ == STT_OBJECT and name and name.startswith("pool_storage_"))
+    for name, size in pools:
+        print(f"pool {name:<16} {size:6d} bytes")
+    print(f"pools: {sum(s for _, s in pools)} bytes no total (pior caso, sem fragmentação)")
+
+    found = sorted({name for name, value, _, typ, _ in syms if typ == STT_FUNC and name in ALLOCATOR and value})
+    if not found:
+        return
+    print(f"{args.elf}: o firmware usa o heap: {', '.join(found)}", file=sys.stderr)
+    for reason in map_reasons(args.elf + ".map"):
+        print("  " + reason, file=sys.stderr)
+    print("use um pool de pool.h no lugar de malloc/free", file=sys.stderr)
+    sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Ajuste ao vivo do controle do soprador (lado do computador de control.c).
+
+Uso:
+    tools/control.py firmware.elf /dev/ttyACM0
+        Mostra a configuração em uso.
+    tools/control.py firmware.elf /dev/ttyACM0 --mode pid --setpoint 60 --kp 200 --ki 0.5
+        Troca só os campos dados e mostra a configuração aplicada.
+
+O quadro 'K' leva control_config_t inteiro (little-endian, 28 bytes); sem
+conteúdo, só pede a configuração. A resposta chega pelo log binário como
+"CTL ok ..." e "CTL pid ...". O ajuste não é gravado na flash: no boot vale
+o CONTROL_MODE do CMake e os valores de control.c.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from log_decode import Elf  # noqa: E402
+from ota import Port, frame  # noqa: E402
+
+CONFIG = "<BBHfffffHH"          # control_config_t
+MODES = {"off": 0, "onoff": 1, "pid": 2}
+MODE_NAMES = {"DESLIGADO": "off", "LIGA/DESL": "onoff", "PID": "pid"}
+ACTIONS = {"cool": 0, "heat": 1}
+
+
+def query(port, payload=b""):
+    """Envia o quadro 'K' e devolve os campos das duas linhas de resposta."""
+    for attempt in range(4):
+        port.send(frame(b"K" + payload))
+        fields = {}
+        for reply in port.replies(1.0, prefix="CTL "):
+            if reply[0].startswith("erro"):
+                sys.exit(f"aparelho recusou: {reply[0]}")
+            if reply[0] in ("ok", "pid"):
+                fields.update(kv.split("=", 1) for kv in reply[1:])
+            if "kp" in fields and "modo" in fields:
+                return fields
+    sys.exit("sem resposta do aparelho")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("elf", help="ELF do firmware em execução (formatos do log)")
+    ap.add_argument("port", help="serial da USB (ex.: /dev/ttyACM0)")
+    ap.add_argument("--mode", choices=MODES)
+    ap.add_argument("--action", choices=ACTIONS, help="cool: soprador; heat: aquecedor")
+    ap.add_argument("--setpoint", type=float, help="°C")
+    ap.add_argument("--hysteresis", type=float, help="°C (liga/desliga)")
+    ap.add_argument("--kp", type=float, help="saída (0..1000) por °C")
+    ap.add_argument("--ki", type=float, help="saída por °C·s")
+    ap.add_argument("--kd", type=float, help="saída por °C/s")
+    ap.add_argument("--min-on", type=int, help="tempo mínimo ligado (s)")
+    ap.add_argument("--min-off", type=int, help="tempo mínimo desligado (s)")
+    args = ap.parse_args()
+
+    port = Port(args.port, Elf(args.elf))
+    cur = query(port)
+    changes = [args.mode, args.action, args.setpoint, args.hysteresis, args.kp,
+               args.ki, args.kd, args.min_on, args.min_off]
+    if any(v is not None for v in changes):
+        # Campos não dados vêm da configuração atual
+        min_on, min_off = map(int, cur["min"].split("/"))
+        pick = lambda new, old: old if new is None else new   # noqa: E731
+        payload = struct.pack(
+            CONFIG,
+            MODES[pick(args.mode, MODE_NAMES[cur["modo"]])],
+            pick(ACTIONS.get(args.action), int(cur["acao"])), 0,
+            pick(args.setpoint, float(cur["alvo"])),
+            pick(args.hysteresis, float(cur["hist"])),
+            pick(args.kp, float(cur["kp"])), pick(args.ki, float(cur["ki"])),
+            pick(args.kd, float(cur["kd"])),
+            pick(args.min_on, min_on), pick(args.min_off, min_off))
+        cur = query(port, payload)
+    print(" ".join(f"{k}={v}" for k, v in cur.items()))
+
+
+if __name__ == "__main__":
+    main()
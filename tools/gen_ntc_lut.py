@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+Gera ntc_lut.h: tabela da razão do divisor do NTC (código de 16 bits) para
+temperatura em centésimos de °C, pela equação de Steinhart-Hart. O firmware
+interpola linearmente entre os pontos em ponto fixo (sensor.c), sem log()
+nem ponto flutuante por amostra.
+
+Divisor: VREF -- R série -- ADC -- NTC -- GND (razão = Rntc / (Rntc + Rs))
+
+Uso:
+    tools/gen_ntc_lut.py saida.h [--series 10000] [--a A] [--b B] [--c C]
+"""
+
+import argparse
+import math
+
+POINTS = 257            # 256 segmentos: índice = código >> 8
+T_MIN, T_MAX = -40.0, 125.0
+
+# NTC 10k B3950 (coeficientes de Steinhart-Hart do fabricante)
+DEFAULT_A = 1.009249522e-3
+DEFAULT_B = 2.378405444e-4
+DEFAULT_C = 2.019202697e-7
+
+
+def celsius(ratio, args):
+    if ratio <= 0.0:
+        return T_MAX
+    if ratio >= 1.0:
+        return T_MIN
+    r = args.series * ratio / (1.0 - ratio)
+    ln = math.log(r)
+    t = 1.0 / (args.a + args.b * ln + args.c * ln ** 3) - 273.15
+    return min(max(t, T_MIN), T_MAX)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("output")
+    ap.add_argument("--series", type=float, default=10000.0)
+    ap.add_argument("--a", type=float, default=DEFAULT_A)
+    ap.add_argument("--b", type=float, default=DEFAULT_B)
+    ap.add_argument("--c", type=float, default=DEFAULT_C)
+    args = ap.parse_args()
+
+    table = [round(celsius(i / (POINTS - 1), args) * 100) for i in range(POINTS)]
+
+    lines = [
+        "// Gerado por tools/gen_ntc_lut.py - não editar",
+        f"// Rs = {args.series:g} ohm, A = {args.a:.9e}, B = {args.b:.9e}, C = {args.c:.9e}",
+        "",
+        "#ifndef NTC_LUT_H",
+        "#define NTC_LUT_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        f"#define NTC_LUT_POINTS {POINTS}",
+        "",
+        "// Temperatura (centésimos de °C) para a razão do divisor i/256",
+        "static const int16_t ntc_lut[NTC_LUT_POINTS] = {",
+    ]
+    for i in range(0, POINTS, 8):
+        lines.append("    " + " ".join(f"{v:6d}," for v in table[i:i + 8]))
+    lines += ["};", "", "#endif", ""]
+
+    with open(args.output, "w", newline="\n") as f:
+        f.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
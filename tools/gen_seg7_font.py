@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""
+Gera seg7_font.h: dígitos grandes (16 pixels de altura) no estilo de display
+de 7 segmentos, já organizados em tiras de colunas por página do SSD1306.
+Cada glifo inclui as colunas de espaçamento à direita, então desenhá-lo
+sobrescreve por completo a área que ocupa.
+
+Uso:
+    tools/gen_seg7_font.py > seg7_font.h
+"""
+
+HEIGHT = 16
+PAGES = HEIGHT // 8
+SPACING = 2
+
+# Segmentos de um dígito 10x16 com traço de 2 pixels: (x0, x1, y0, y1) inclusivos
+SEGMENTS = {
+    "a": (1, 8, 0, 1),
+    "b": (8, 9, 1, 7),
+    "c": (8, 9, 8, 14),
+    "d": (1, 8, 14, 15),
+    "e": (0, 1, 8, 14),
+    "f": (0, 1, 1, 7),
+    "g": (1, 8, 7, 8),
+}
+
+# (caractere, largura sem espaçamento, segmentos ou pixels avulsos)
+GLYPHS = [
+    ("0", 10, "abcdef"),
+    ("1", 10, "bc"),
+    ("2", 10, "abdeg"),
+    ("3", 10, "abcdg"),
+    ("4", 10, "bcfg"),
+    ("5", 10, "acdfg"),
+    ("6", 10, "acdefg"),
+    ("7", 10, "abc"),
+    ("8", 10, "abcdefg"),
+    ("9", 10, "abcdfg"),
+    ("-", 10, "g"),
+    ("C", 10, "adef"),
+    ("F", 10, "aefg"),
+    (" ", 10, ""),
+    (".", 3, [(0, 2, 14, 15)]),
+    ("o", 5, [(1, 3, 0, 0), (0, 0, 1, 3), (4, 4, 1, 3), (1, 3, 4, 4)]),  # símbolo de grau
+]
+
+
+def render(width, shape):
+    rects = [SEGMENTS[s] for s in shape] if isinstance(shape, str) else shape
+    cols = [[0] * PAGES for _ in range(width + SPACING)]
+    for x0, x1, y0, y1 in rects:
+        for x in range(x0, x1 + 1):
+            for y in range(y0, y1 + 1):
+                cols[x][y // 8] |= 1 << (y % 8)
+    return cols
+
+
+def main():
+    print("/**")
+    print(" * Fonte de 7 segmentos com 16 pixels de altura (gerada por")
+    print(" * tools/gen_seg7_font.py - não editar).")
+    print(" *")
+    print(" * Cada glifo é guardado como tiras de colunas por página: primeiro as")
+    print(" * colunas da página de cima, depois as da página de baixo. A largura já")
+    print(" * inclui as colunas de espaçamento. 'o' é o símbolo de grau.")
+    print(" */")
+    print()
+    print("#ifndef SEG7_FONT_H")
+    print("#define SEG7_FONT_H")
+    print()
+    print("#include <stdint.h>")
+    print()
+    print(f"#define SEG7_HEIGHT {HEIGHT}")
+    print(f"#define SEG7_PAGES  {PAGES}")
+    print()
+    print(f'static const char seg7_chars[] = "{"".join(g[0] for g in GLYPHS)}";')
+    print()
+    widths, offsets, data = [], [], []
+    for ch, width, shape in GLYPHS:
+        cols = render(width, shape)
+        offsets.append(len(data))
+        widths.append(len(cols))
+        for page in range(PAGES):
+            data.extend(c[page] for c in cols)
+    print("static const uint8_t seg7_width[] = { " + ", ".join(map(str, widths)) + " };")
+    print("static const uint16_t seg7_offset[] = { " + ", ".join(map(str, offsets)) + " };")
+    print()
+    print("static const uint8_t seg7_strips[] = {")
+    for (ch, _, _), off, w in zip(GLYPHS, offsets, widths):
+        chunk = data[off:off + w * PAGES]
+        print("    " + ", ".join(f"0x{b:02x}" for b in chunk) + f", // {ch}")
+    print("};")
+    print()
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()
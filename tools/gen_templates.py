@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+Pré-renderiza as partes estáticas das telas (screens.layout) em framebuffers
+constantes, gerando um header C com um array por tela. Os arrays ficam em
+flash e são copiados por DMA para o framebuffer no início de cada redesenho.
+
+Uso:
+    tools/gen_templates.py screens.layout ssd1306_font.h icons.h saida.h
+"""
+
+import re
+import sys
+
+WIDTH = 128
+HEIGHT = 32
+PAGES = HEIGHT // 8
+PUNCT = ".-:/%+"  # Glifos após o '9' em ssd1306_font.h
+
+
+def parse_arrays(path):
+    """Lê todos os arrays de bytes 'nome[] = { ... };' de um header C."""
+    text = open(path, encoding="utf-8").read()
+    arrays = {}
+    for m in re.finditer(r"(\w+)\s*\[\s*\]\s*=\s*\{([^}]*)\}", text):
+        body = re.sub(r"//[^\n]*", "", m.group(2))
+        arrays[m.group(1)] = [int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\b\d+\b", body)]
+    return arrays
+
+
+def font_index(ch):
+    # Mesma regra de GetFontIndex() em ssd1306.c
+    ch = ch.upper()
+    if "A" <= ch <= "Z":
+        return ord(ch) - ord("A") + 1
+    if "0" <= ch <= "9":
+        return ord(ch) - ord("0") + 27
+    if ch and ch in PUNCT:
+        return 37 + PUNCT.index(ch)
+    return 0
+
+
+def write_string(buf, font, x, y, text):
+    # Mesmas regras de WriteString()/WriteChar() em ssd1306.c
+    if x > WIDTH - 8 or y > HEIGHT - 8:
+        return
+    for ch in text:
+        if x > WIDTH - 8:
+            break
+        idx = font_index(ch)
+        base = (y // 8) * WIDTH + x
+        buf[base:base + 8] = font[idx * 8:idx * 8 + 8]
+        x += 8
+
+
+def draw_icon(buf, data, x, y):
+    # Ícones de uma página (8 pixels de altura), como os de icons.h
+    if y % 8:
+        sys.exit(f"ícone em y={y}: deve ser múltiplo de 8")
+    base = (y // 8) * WIDTH + x
+    for i, b in enumerate(data[:WIDTH - x]):
+        buf[base + i] |= b
+
+
+def main():
+    if len(sys.argv) != 5:
+        sys.exit(__doc__)
+    layout_path, font_path, icons_path, out_path = sys.argv[1:]
+    font = parse_arrays(font_path)["font"]
+    icons = parse_arrays(icons_path)
+
+    screens = {}
+    for lineno, line in enumerate(open(layout_path, encoding="utf-8"), 1):
+        line = line.strip()
+        if not line or line.startswith("#"):
+            continue
+        fields = line.split(None, 4)
+        if len(fields) != 5:
+            sys.exit(f"{layout_path}:{lineno}: esperado 'tela tipo x y conteúdo'")
+        name, kind, x, y, content = fields
+        buf = screens.setdefault(name, bytearray(WIDTH * PAGES))
+        if kind == "text":
+            write_string(buf, font, int(x), int(y), content)
+        elif kind == "icon":
+            if content not in icons:
+                sys.exit(f"{layout_path}:{lineno}: ícone '{content}' não existe em {icons_path}")
+            draw_icon(buf, icons[content], int(x), int(y))
+        else:
+            sys.exit(f"{layout_path}:{lineno}: tipo desconhecido '{kind}'")
+
+    with open(out_path, "w", encoding="utf-8") as out:
+        out.write("// Gerado por tools/gen_templates.py a partir de screens.layout - não editar\n\n")
+        out.write("#ifndef SCREEN_TEMPLATES_H\n#define SCREEN_TEMPLATES_H\n\n")
+        out.write("#include <stdint.h>\n#include \"ssd1306.h\"\n\n")
+        for name, buf in screens.items():
+            out.write(f"static const uint8_t __attribute__((aligned(4))) "
+                      f"screen_template_{name}[SSD1306_BUF_LEN] = {{\n")
+            for i in range(0, len(buf), 16):
+                out.write("    " + ", ".join(f"0x{b:02x}" for b in buf[i:i + 16]) + ",\n")
+            out.write("};\n\n")
+        out.write("#endif\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,281 @@
+/**
+ * acq_ads1115.c no computador contra um modelo dos registradores do
+ * ADS1115, comandado por tools/ads1115_test.py
+ *
+ * O modelo fica no endereço 0x48 do barramento de tools/host/i2c_bus.c:
+ * ponteiro, conversão, configuração e limiares como no datasheet. Em modo
+ * contínuo converte AIN0 na taxa do campo DR e, com os limiares no modo
+ * RDY (Hi_thresh com o bit 15 em 1 e Lo_thresh com ele em 0, comparador
+ * ligado), o ALERT/RDY (GP16) pulsa por 8 µs ao fim de cada conversão. Os
+ * cenários conferem a inicialização, a leitura de cada conversão sinalizada
+ * pelo RDY, a média entregue ao timer, um loop principal lento, a saturação
+ * e o conversor ausente.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+#include "acq.h"
+
+#define ADS_ADDR        0x48
+#define ADS_RDY_PIN     16
+#define RDY_PULSE_US    8       // Pulso do ALERT/RDY em modo contínuo
+#define MAX_WRITES      16
+
+// Registradores do modelo (índice = ponteiro)
+enum { REG_CONV, REG_CONFIG, REG_LO, REG_HI };
+
+static const uint16_t data_rates[8] = { 8, 16, 32, 64, 128, 250, 475, 860 };
+static const float pga_fsr[8] = { 6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f, 0.256f, 0.256f };
+
+static struct {
+    bool present;
+    uint8_t pointer;
+    uint16_t reg[4];
+    float (*input)(uint32_t n);     // Tensão no AIN0 na n-ésima conversão
+    int alarm;
+    bool pulse;                     // RDY ativo, volta após RDY_PULSE_US
+    uint64_t next_conv;
+    // Contadores desde ads_clear()
+    uint32_t conversions;
+    uint32_t conv_reads;            // Leituras do registrador de conversão
+    uint32_t repeated_reads;        // A mesma conversão lida de novo
+    uint32_t other_reads;           // Leituras de outro registrador
+    int64_t read_sum;               // Soma dos códigos lidos
+    uint8_t writes[MAX_WRITES];     // Ponteiro de cada escrita
+    uint32_t write_count;
+    bool read_since_conv;
+} ads;
+
+static float volts_const;
+static float input_const(uint32_t n) { return volts_const; }
+static float input_ramp(uint32_t n) { return 0.2f + 0.003f * (n % 64); }
+
+static bool continuous(void) {
+    return !(ads.reg[REG_CONFIG] & 0x0100);
+}
+
+static bool rdy_mode(void) {
+    return (ads.reg[REG_HI] & 0x8000) && !(ads.reg[REG_LO] & 0x8000) && (ads.reg[REG_CONFIG] & 3) != 3;
+}
+
+static uint32_t conv_period_us(void) {
+    return 1000000u / data_rates[(ads.reg[REG_CONFIG] >> 5) & 7];
+}
+
+// COMP_POL = 0: ativo em nível baixo
+static void rdy_set(bool active) {
+    bool active_high = ads.reg[REG_CONFIG] & 0x0008;
+    host_gpio_set(ADS_RDY_PIN, active == active_high);
+}
+
+static void ads_convert(void) {
+    float fsr = pga_fsr[(ads.reg[REG_CONFIG] >> 9) & 7];
+    // Só AIN0 x GND (MUX = 100) está ligado; as outras entradas leem 0 V
+    float v = ((ads.reg[REG_CONFIG] >> 12) & 7) == 4 ? ads.input(ads.conversions) : 0.0f;
+    long code = lroundf(v / fsr * 32768.0f);
+    if (code > 32767) code = 32767;
+    if (code < -32768) code = -32768;
+    ads.reg[REG_CONV] = (uint16_t)code;
+    ads.conversions++;
+    ads.read_since_conv = false;
+}
+
+static void ads_alarm(uint alarm) {
+    if (ads.pulse) {
+        ads.pulse = false;
+        rdy_set(false);
+    } else if (continuous()) {
+        ads_convert();
+        ads.next_conv += conv_period_us();
+        if (rdy_mode()) {
+            ads.pulse = true;
+            rdy_set(true);
+            hardware_alarm_set_target(ads.alarm, time_us_64() + RDY_PULSE_US);
+            return;
+        }
+    }
+    if (continuous()) hardware_alarm_set_target(ads.alarm, ads.next_conv);
+}
+
+static bool ads_device(int16_t prefix, const uint8_t *tx, uint16_t tx_len, uint8_t *rx, uint16_t rx_len) {
+    if (!ads.present) return false;
+    // O prefixo da transação é o primeiro byte escrito
+    uint8_t w[3];
+    uint16_t n = 0;
+    if (prefix >= 0) w[n++] = (uint8_t)prefix;
+    for (uint16_t i = 0; i < tx_len && n < sizeof(w); i++) w[n++] = tx[i];
+    if (n) {
+        ads.pointer = w[0] & 3;
+        if (ads.write_count < MAX_WRITES) ads.writes[ads.write_count] = ads.pointer;
+        ads.write_count++;
+    }
+    if (n == 3 && ads.pointer != REG_CONV) {
+        bool was_continuous = continuous();
+        ads.reg[ads.pointer] = (uint16_t)(w[1] << 8 | w[2]);
+        ads.reg[REG_CONFIG] &= 0x7FFF;      // OS só inicia conversão avulsa (não modelada)
+        // Entrar no modo contínuo começa a primeira conversão
+        if (ads.pointer == REG_CONFIG && continuous() && !was_continuous) {
+            ads.next_conv = time_us_64() + conv_period_us();
+            hardware_alarm_set_target(ads.alarm, ads.next_conv);
+        }
+    }
+    if (rx_len) {
+        uint16_t v = ads.reg[ads.pointer];
+        if (ads.pointer == REG_CONV) {
+            ads.conv_reads++;
+            ads.repeated_reads += ads.read_since_conv;
+            ads.read_since_conv = true;
+            ads.read_sum += (int16_t)v;
+        } else {
+            ads.other_reads++;
+        }
+        rx[0] = v >> 8;
+        if (rx_len > 1) rx[1] = v & 0xFF;
+    }
+    return true;
+}
+
+static void ads_attach(void) {
+    // Valores do reset (datasheet): conversão avulsa, comparador desligado
+    ads.reg[REG_CONV] = 0x0000;
+    ads.reg[REG_CONFIG] = 0x0583;
+    ads.reg[REG_LO] = 0x8000;
+    ads.reg[REG_HI] = 0x7FFF;
+    ads.present = true;
+    ads.input = input_const;
+    ads.alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(ads.alarm, ads_alarm);
+    host_gpio_set(ADS_RDY_PIN, true);       // Dreno aberto com pull-up
+    host_i2c_attach(ADS_ADDR, ads_device);
+}
+
+static void ads_clear(void) {
+    ads.conversions = ads.conv_reads = ads.repeated_reads = ads.other_reads = 0;
+    ads.read_sum = 0;
+    ads.write_count = 0;
+}
+
+// Loop principal: o poll do backend a cada poll_us por ms. No fim o loop
+// volta a ser rápido até a última conversão ter sido lida, para o cenário
+// seguinte começar sem RDY pendente
+static void run(uint32_t ms, uint32_t poll_us) {
+    uint64_t end = time_us_64() + ms * 1000ull;
+    while (time_us_64() < end) {
+        host_run_until(time_us_64() + poll_us);
+        acq_ads1115.poll();
+    }
+    while (!ads.read_since_conv || !i2c_bus_idle()) {
+        host_run_until(time_us_64() + 100);
+        acq_ads1115.poll();
+    }
+}
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                       \
+        if (!(cond)) {                              \
+            failures++;                             \
+            printf("  falhou: " __VA_ARGS__);       \
+            putchar('\n');                          \
+        }                                           \
+    } while (0)
+
+static const char *logged = NULL;
+static void log_record(const char *fmt, const uint32_t *args, uint32_t nargs) {
+    logged = fmt;
+}
+
+// Média das conversões lidas, como ads_read() deve entregar
+static void check_sample(const char *name) {
+    acq_sample_t s;
+    CHECK(acq_ads1115.read(&s), "%s: sem leitura com %u conversões lidas", name, ads.conv_reads);
+    if (ads.conv_reads == 0) return;
+    int32_t mean = (int32_t)(ads.read_sum / (int64_t)ads.conv_reads);
+    float volts = (float)ads.read_sum / ads.conv_reads * 1.024f / 32768.0f;
+    CHECK(s.code == (uint32_t)(mean < 0 ? 0 : mean), "%s: código %u, esperado %d", name, s.code, mean);
+    CHECK(fabsf(s.voltage - volts) < 1e-6f, "%s: tensão %.6f, esperado %.6f", name, s.voltage, volts);
+    CHECK(!acq_ads1115.read(&s), "%s: leitura repetida sem conversão nova", name);
+}
+
+static void scenario(const char *name) {
+    printf("%s\n", name);
+    ads_clear();
+}
+
+int main(void) {
+    host_log = log_record;
+    i2c_init(i2c_default, 400000);
+    i2c_bus_init(i2c_default);
+    ads_attach();
+
+    scenario("inicialização");
+    acq_ads1115.init();
+    static const uint8_t order[] = { REG_LO, REG_HI, REG_CONFIG, REG_CONV };
+    CHECK(ads.write_count == 4 && !memcmp(ads.writes, order, 4),
+          "escritas fora da ordem Lo, Hi, config, ponteiro (%u escritas)", ads.write_count);
+    CHECK(ads.reg[REG_CONFIG] == 0x4680, "config 0x%04x", ads.reg[REG_CONFIG]);
+    CHECK(rdy_mode() && continuous(), "ALERT/RDY fora do modo RDY contínuo");
+    CHECK(ads.pointer == REG_CONV, "ponteiro em %u", ads.pointer);
+    CHECK(logged == NULL, "log na inicialização: %s", logged);
+
+    // 128 SPS: cada pulso do RDY vira uma leitura de dois bytes, sem
+    // escrever o ponteiro de novo
+    scenario("contínuo, 0,5 V");
+    volts_const = 0.5f;
+    ads.input = input_const;
+    run(100, 100);
+    CHECK(ads.conversions == 12 || ads.conversions == 13, "%u conversões em 100 ms", ads.conversions);
+    CHECK(ads.conv_reads == ads.conversions, "%u leituras para %u conversões", ads.conv_reads, ads.conversions);
+    CHECK(ads.repeated_reads == 0 && ads.other_reads == 0 && ads.write_count == 0,
+          "acessos além da conversão: %u repetidas, %u outras, %u escritas",
+          ads.repeated_reads, ads.other_reads, ads.write_count);
+    CHECK(ads.read_sum == 16000 * (int64_t)ads.conv_reads, "soma %lld", (long long)ads.read_sum);
+    check_sample("0,5 V");
+
+    scenario("média de uma rampa");
+    ads.input = input_ramp;
+    run(250, 100);
+    CHECK(ads.conv_reads == ads.conversions && ads.repeated_reads == 0,
+          "%u leituras para %u conversões", ads.conv_reads, ads.conversions);
+    check_sample("rampa");
+
+    // Loop principal ocupado: conversões se perdem, mas cada leitura é de
+    // uma conversão nova e o RDY travado não vira leitura dupla
+    scenario("poll a cada 20 ms");
+    run(500, 20000);
+    CHECK(ads.conv_reads < ads.conversions && ads.conv_reads >= 24,
+          "%u leituras para %u conversões", ads.conv_reads, ads.conversions);
+    CHECK(ads.repeated_reads == 0, "%u conversões lidas duas vezes", ads.repeated_reads);
+    check_sample("poll lento");
+
+    scenario("entrada negativa");
+    volts_const = -0.05f;
+    ads.input = input_const;
+    run(50, 100);
+    acq_sample_t s;
+    CHECK(acq_ads1115.read(&s) && s.code == 0 && fabsf(s.voltage + 0.05f) < 1e-4f,
+          "código %u, tensão %.5f", s.code, s.voltage);
+
+    scenario("saturação");
+    volts_const = 2.0f;
+    run(50, 100);
+    CHECK(acq_ads1115.read(&s) && s.code == 32767, "código %u", s.code);
+
+    scenario("sem conversão");
+    CHECK(!acq_ads1115.read(&s), "leitura sem conversão nova");
+
+    scenario("conversor ausente");
+    ads.present = false;
+    acq_ads1115.init();
+    CHECK(logged && strstr(logged, "ADS1115"), "inicialização sem log");
+
+    printf(failures ? "%d falha(s)\n" : "ok\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * Desenho de bitmaps no computador: blit.c sobre um framebuffer de teste,
+ * comandado por tools/blit_test.py
+ *
+ * Uma linha por caso na entrada padrão:
+ *   MODO X Y LARGURA ALTURA RLE HEX
+ * (MODO 0..3 como blit_mode_t, RLE 0 ou 1, HEX os bytes do bitmap). O
+ * framebuffer começa com listras diagonais, para que COPY, OR, AND e XOR
+ * deem resultados diferentes, e sai inteiro em hexadecimal numa linha.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+#include "blit.h"
+
+#define FB_SIZE (SSD1306_WIDTH * SSD1306_NUM_PAGES)
+#define BMP_MAX 2048
+
+// Pixel (x, y) aceso quando (x + y) % 3 == 0
+static void background(uint8_t *buf) {
+    for (int p = 0; p < (int)SSD1306_NUM_PAGES; p++) {
+        for (int x = 0; x < SSD1306_WIDTH; x++) {
+            uint8_t b = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                if ((x + p * 8 + bit) % 3 == 0) b |= 1u << bit;
+            }
+            buf[p * SSD1306_WIDTH + x] = b;
+        }
+    }
+}
+
+int main(void) {
+    static char line[2 * BMP_MAX + 64];
+    static uint8_t data[BMP_MAX];
+    // Margem dos dois lados: uma escrita fora do framebuffer aparece no teste
+    static uint8_t guard[FB_SIZE + 2 * SSD1306_WIDTH];
+    uint8_t *buf = guard + SSD1306_WIDTH;
+
+    blit_dma_init();
+    while (fgets(line, sizeof(line), stdin)) {
+        int mode, x, y, w, h, rle, pos;
+        if (sscanf(line, "%d %d %d %d %d %d %n", &mode, &x, &y, &w, &h, &rle, &pos) != 6) {
+            fprintf(stderr, "caso inválido: %s", line);
+            return 2;
+        }
+        size_t n = 0;
+        unsigned b;
+        while (n < sizeof(data) && sscanf(line + pos + 2 * n, "%2x", &b) == 1) data[n++] = b;
+
+        memset(guard, 0xA5, sizeof(guard));
+        background(buf);
+        bitmap_t bmp = { data, w, h, rle };
+        blit(buf, x, y, &bmp, (blit_mode_t)mode);
+
+        for (int i = 0; i < SSD1306_WIDTH; i++) {
+            if (guard[i] != 0xA5 || guard[SSD1306_WIDTH + FB_SIZE + i] != 0xA5) {
+                fprintf(stderr, "escrita fora do framebuffer: %s", line);
+                return 1;
+            }
+        }
+        for (int i = 0; i < FB_SIZE; i++) printf("%02x", buf[i]);
+        putchar('\n');
+    }
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+static inline void adc_init(void) {}
+static inline void adc_gpio_init(uint gpio) { (void)gpio; }
+void adc_select_input(uint input);
+void adc_set_round_robin(uint input_mask);
+uint16_t adc_read(void);
+
+// Tensão na entrada (V); adc_read() devolve o código de 12 bits dela
+void host_adc_set(uint input, float volts);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+
+#include "pico/stdlib.h"
+
+// Sem canais livres: quem aceita ficar sem DMA usa o caminho por CPU
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+static inline int dma_claim_unused_channel(bool required) { (void)required; return -1; }
+static inline dma_channel_config dma_channel_get_default_config(uint channel) { (void)channel; return (dma_channel_config){ 0 }; }
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { (void)c; (void)size; }
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+static inline void dma_channel_configure(uint channel, const dma_channel_config *c, volatile void *write_addr,
+                                         const volatile void *read_addr, uint transfer_count, bool trigger) {
+    (void)channel; (void)c; (void)write_addr; (void)read_addr; (void)transfer_count; (void)trigger;
+}
+static inline void dma_channel_wait_for_finish_blocking(uint channel) { (void)channel; }
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+#define PICO_FLASH_SIZE_BYTES   (2 * 1024 * 1024)
+#define FLASH_PAGE_SIZE         (1u << 8)
+#define FLASH_SECTOR_SIZE       (1u << 12)
+
+// A flash vista pelo XIP é este array: quem lê por XIP_BASE + offset lê a
+// flash do host
+extern uint8_t host_flash[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t)host_flash)
+
+// Flash NOR: o apagamento deixa o setor em 0xFF e a gravação só zera bits
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+// Apagamentos e gravações feitos; com host_flash_cut_at >= 0, a energia cai
+// no lugar dessa operação (host_power_off)
+extern uint32_t host_flash_ops;
+extern int32_t host_flash_cut_at;
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef HOST_HARDWARE_GPIO_H
+#define HOST_HARDWARE_GPIO_H
+
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+
+#define GPIO_IN     false
+#define GPIO_OUT    true
+
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 0x1u,
+    GPIO_IRQ_LEVEL_HIGH = 0x2u,
+    GPIO_IRQ_EDGE_FALL = 0x4u,
+    GPIO_IRQ_EDGE_RISE = 0x8u,
+};
+
+static inline void gpio_init(uint gpio) { (void)gpio; }
+static inline void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+bool gpio_get(uint gpio);
+void gpio_put(uint gpio, bool value);
+
+// Interrupções de borda: o evento fica travado até gpio_acknowledge_irq(),
+// como no IO_BANK0 (os de nível não são modelados)
+void gpio_add_raw_irq_handler(uint gpio, irq_handler_t handler);
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled);
+uint32_t gpio_get_irq_event_mask(uint gpio);
+void gpio_acknowledge_irq(uint gpio, uint32_t events);
+
+// Nível de uma entrada, visto pelo firmware em gpio_get(); as bordas
+// habilitadas chamam os handlers na hora
+void host_gpio_set(uint gpio, bool level);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    uint baudrate;
+} i2c_inst_t;
+
+extern i2c_inst_t host_i2c0;
+#define i2c_default (&host_i2c0)
+
+static inline uint i2c_init(i2c_inst_t *i2c, uint baudrate) { i2c->baudrate = baudrate; return baudrate; }
+
+// Dispositivo no barramento (tools/host/i2c_bus.c): chamado ao fim de cada
+// transação para o endereço dele, com o que foi escrito (o prefixo, se
+// houver, antes de tx) e o buffer da leitura; false = sem ACK
+typedef bool (*host_i2c_device_t)(int16_t prefix, const uint8_t *tx, uint16_t tx_len,
+                                  uint8_t *rx, uint16_t rx_len);
+
+void host_i2c_attach(uint8_t addr, host_i2c_device_t device);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+#define PICO_HIGHEST_IRQ_PRIORITY   0x00
+#define IO_IRQ_BANK0                13
+
+typedef void (*irq_handler_t)(void);
+
+static inline void irq_set_priority(uint num, uint8_t priority) { (void)num; (void)priority; }
+// Só o IO_IRQ_BANK0 (interrupções do GPIO) é modelado; os outros são ignorados
+void irq_set_enabled(uint num, bool enabled);
+
+#endif
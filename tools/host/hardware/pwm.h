@@ -0,0 +1,18 @@
+#ifndef HOST_HARDWARE_PWM_H
+#define HOST_HARDWARE_PWM_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    float div;
+    uint16_t top;
+} pwm_config;
+
+static inline uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1) & 7; }
+static inline pwm_config pwm_get_default_config(void) { return (pwm_config){ 1.0f, 0xFFFF }; }
+static inline void pwm_config_set_clkdiv(pwm_config *c, float div) { c->div = div; }
+static inline void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) { c->top = wrap; }
+static inline void pwm_init(uint slice, pwm_config *c, bool start) { (void)slice; (void)c; (void)start; }
+void pwm_set_gpio_level(uint gpio, uint16_t level);
+
+#endif
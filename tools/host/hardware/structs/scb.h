@@ -0,0 +1,17 @@
+#ifndef HOST_HARDWARE_STRUCTS_SCB_H
+#define HOST_HARDWARE_STRUCTS_SCB_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    volatile uint32_t aircr;
+} host_scb_t;
+
+extern host_scb_t host_scb;
+
+// O firmware só escreve no SCB para pedir o reset (SYSRESETREQ): o acesso
+// desliga o aparelho antes da escrita (host_power_off)
+void host_scb_reset(void);
+#define scb_hw (host_scb_reset(), &host_scb)
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+// Uma só linha de execução: não há o que mascarar
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+static inline void __dmb(void) {}
+
+typedef volatile uint32_t spin_lock_t;
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) { (void)lock; return 0; }
+static inline void spin_unlock(spin_lock_t *lock, uint32_t status) { (void)lock; (void)status; }
+
+#endif
@@ -0,0 +1,238 @@
+/**
+ * Relógio virtual, alarmes de hardware, GPIO (com as interrupções de borda),
+ * ADC e saídas PWM no computador
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/pwm.h"
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+#include "hardware/flash.h"
+#include "hardware/structs/scb.h"
+
+#define HOST_ALARMS 4
+#define HOST_GPIOS  30
+#define HOST_GPIO_HANDLERS 4
+#define HOST_ADC_INPUTS 5
+#define HOST_STDIN_SIZE 4096
+
+static uint64_t now_us = 0;
+static struct {
+    bool claimed, armed;
+    uint64_t target;
+    hardware_alarm_callback_t callback;
+} alarms[HOST_ALARMS];
+static uint16_t pwm_levels[HOST_GPIOS];
+static bool gpio_levels[HOST_GPIOS];
+static uint32_t gpio_irq_enabled[HOST_GPIOS];
+static uint32_t gpio_irq_events[HOST_GPIOS];
+static irq_handler_t gpio_irq_handlers[HOST_GPIO_HANDLERS];
+static int gpio_irq_handler_count = 0;
+static bool bank0_enabled = false;
+static float adc_volts[HOST_ADC_INPUTS];
+static uint adc_input = 0;
+static uint32_t adc_rr_mask = 0;
+static uint8_t stdin_buf[HOST_STDIN_SIZE];
+static size_t stdin_pos = 0, stdin_len = 0;
+
+uint8_t host_flash[PICO_FLASH_SIZE_BYTES];
+uint32_t host_flash_ops = 0;
+int32_t host_flash_cut_at = -1;
+host_scb_t host_scb;
+void (*host_log)(const char *fmt, const uint32_t *args, uint32_t nargs);
+void (*host_power_off)(const char *why);
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+
+int hardware_alarm_claim_unused(bool required) {
+    for (int i = 0; i < HOST_ALARMS; i++) {
+        if (!alarms[i].claimed) {
+            alarms[i].claimed = true;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback) {
+    alarms[alarm_num].callback = callback;
+}
+
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t) {
+    if (t <= now_us) return true;
+    alarms[alarm_num].target = t;
+    alarms[alarm_num].armed = true;
+    return false;
+}
+
+// Sem atraso de interrupção: o alarme entra exatamente no alvo. O relógio
+// não volta: um alvo já passado só dispara o que venceu
+void host_run_until(uint64_t t_us) {
+    while (1) {
+        int next = -1;
+        for (int i = 0; i < HOST_ALARMS; i++) {
+            if (alarms[i].armed && alarms[i].target <= t_us &&
+                (next < 0 || alarms[i].target < alarms[next].target)) next = i;
+        }
+        if (next < 0) break;
+        if (alarms[next].target > now_us) now_us = alarms[next].target;
+        alarms[next].armed = false;
+        if (alarms[next].callback) alarms[next].callback(next);
+    }
+    if (t_us > now_us) now_us = t_us;
+}
+
+void host_idle(void) {
+    int next = -1;
+    for (int i = 0; i < HOST_ALARMS; i++) {
+        if (alarms[i].armed && (next < 0 || alarms[i].target < alarms[next].target)) next = i;
+    }
+    if (next < 0) {
+        // Nada mais vai mudar o que está sendo esperado
+        fprintf(stderr, "espera ocupada sem alarme armado (t=%llu us)\n", (unsigned long long)now_us);
+        abort();
+    }
+    host_run_until(alarms[next].target);
+}
+
+bool gpio_get(uint gpio) {
+    return gpio < HOST_GPIOS && gpio_levels[gpio];
+}
+
+void gpio_put(uint gpio, bool value) {
+    host_gpio_set(gpio, value);
+}
+
+void gpio_add_raw_irq_handler(uint gpio, irq_handler_t handler) {
+    if (gpio_irq_handler_count < HOST_GPIO_HANDLERS) gpio_irq_handlers[gpio_irq_handler_count++] = handler;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled) {
+    // Como no SDK, habilitar limpa as bordas travadas antes
+    gpio_irq_events[gpio] &= ~events;
+    if (enabled) gpio_irq_enabled[gpio] |= events;
+    else gpio_irq_enabled[gpio] &= ~events;
+}
+
+uint32_t gpio_get_irq_event_mask(uint gpio) {
+    return gpio_irq_events[gpio] & gpio_irq_enabled[gpio];
+}
+
+void gpio_acknowledge_irq(uint gpio, uint32_t events) {
+    gpio_irq_events[gpio] &= ~events;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (num == IO_IRQ_BANK0) bank0_enabled = enabled;
+}
+
+// Os handlers do banco são compartilhados: todos rodam e cada um confere o
+// seu pino. Um evento que sobra sem reconhecimento manteria a interrupção
+// ativa para sempre no RP2040
+void host_gpio_set(uint gpio, bool level) {
+    if (gpio >= HOST_GPIOS || gpio_levels[gpio] == level) return;
+    gpio_levels[gpio] = level;
+    gpio_irq_events[gpio] |= level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+    if (!bank0_enabled || !gpio_get_irq_event_mask(gpio)) return;
+    for (int i = 0; i < gpio_irq_handler_count; i++) gpio_irq_handlers[i]();
+    if (gpio_get_irq_event_mask(gpio)) {
+        fprintf(stderr, "interrupção do GPIO %u não reconhecida (t=%llu us)\n", gpio,
+                (unsigned long long)now_us);
+        abort();
+    }
+}
+
+void adc_select_input(uint input) {
+    adc_input = input;
+}
+
+void adc_set_round_robin(uint input_mask) {
+    adc_rr_mask = input_mask;
+}
+
+// Código de 12 bits da tensão na entrada; o round-robin passa à seguinte
+uint16_t adc_read(void) {
+    float v = adc_input < HOST_ADC_INPUTS ? adc_volts[adc_input] : 0.0f;
+    long code = lroundf(v / 3.3f * 4096.0f);
+    for (uint i = 1; adc_rr_mask && i <= HOST_ADC_INPUTS; i++) {
+        uint next = (adc_input + i) % HOST_ADC_INPUTS;
+        if (adc_rr_mask & (1u << next)) {
+            adc_input = next;
+            break;
+        }
+    }
+    return code < 0 ? 0 : code > 4095 ? 4095 : (uint16_t)code;
+}
+
+void host_adc_set(uint input, float volts) {
+    if (input < HOST_ADC_INPUTS) adc_volts[input] = volts;
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    if (gpio < HOST_GPIOS) pwm_levels[gpio] = level;
+}
+
+uint16_t host_pwm_level(uint gpio) {
+    return gpio < HOST_GPIOS ? pwm_levels[gpio] : 0;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    return stdin_pos < stdin_len ? stdin_buf[stdin_pos++] : PICO_ERROR_TIMEOUT;
+}
+
+void host_stdin_push(const uint8_t *data, size_t len) {
+    memmove(stdin_buf, stdin_buf + stdin_pos, stdin_len - stdin_pos);
+    stdin_len -= stdin_pos;
+    stdin_pos = 0;
+    if (len > HOST_STDIN_SIZE - stdin_len) len = HOST_STDIN_SIZE - stdin_len;   // Buffer da USB cheio
+    memcpy(stdin_buf + stdin_len, data, len);
+    stdin_len += len;
+}
+
+static void power_off(const char *why) {
+    if (host_power_off) host_power_off(why);
+    fprintf(stderr, "aparelho desligado (%s) sem host_power_off\n", why);
+    abort();
+}
+
+static void flash_op(void) {
+    if (host_flash_cut_at >= 0 && host_flash_ops == (uint32_t)host_flash_cut_at) power_off("corte");
+    host_flash_ops++;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        fprintf(stderr, "apagamento fora dos setores: %u + %zu\n", flash_offs, count);
+        abort();
+    }
+    flash_op();
+    memset(host_flash + flash_offs, 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        fprintf(stderr, "gravação fora das páginas: %u + %zu\n", flash_offs, count);
+        abort();
+    }
+    flash_op();
+    for (size_t i = 0; i < count; i++) host_flash[flash_offs + i] &= data[i];
+}
+
+void host_scb_reset(void) {
+    power_off("reset");
+}
+
+// O log binário não sai do computador: os registros vão para host_log, se houver
+void log_write(uint32_t id, const uint32_t *args, uint32_t nargs) {
+    if (host_log) host_log((const char *)(uintptr_t)id, args, nargs);
+}
+
+void log_flush(void) {
+}
@@ -0,0 +1,123 @@
+/**
+ * Gerenciador do barramento I2C no computador: a interface de i2c_bus.h
+ * sobre o relógio virtual
+ *
+ * Mesma fila com duas prioridades do i2c_bus.c do firmware; cada transação
+ * ocupa o barramento pelo tempo dos seus bytes no clock de i2c_init() (9
+ * bits por byte, com o endereço e o RESTART da leitura) mais o STOP e a
+ * interrupção, num alarme de hardware do host. Ao fim dela o dispositivo
+ * ligado ao endereço (host_i2c_attach()) recebe os bytes escritos e
+ * preenche os lidos, e o callback da transação é chamado como na
+ * interrupção de STOP.
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+
+#define TXN_OVERHEAD_US 25      // START/STOP e a interrupção por transação
+#define HOST_I2C_DEVICES 4
+
+i2c_inst_t host_i2c0 = { .baudrate = 100000 };
+i2c_dev_stats_t i2c_bus_stats[I2C_DEV_COUNT];
+
+static i2c_inst_t *bus = &host_i2c0;
+static int alarm_num = -1;
+static i2c_txn_t *queue_head[I2C_PRIO_COUNT];
+static i2c_txn_t *queue_tail[I2C_PRIO_COUNT];
+static i2c_txn_t *current = NULL;
+static struct {
+    uint8_t addr;
+    host_i2c_device_t device;
+} devices[HOST_I2C_DEVICES];
+static int device_count = 0;
+
+void host_i2c_attach(uint8_t addr, host_i2c_device_t device) {
+    if (device_count < HOST_I2C_DEVICES) {
+        devices[device_count].addr = addr;
+        devices[device_count].device = device;
+        device_count++;
+    }
+}
+
+static i2c_txn_t *queue_pop(void) {
+    for (int p = 0; p < I2C_PRIO_COUNT; p++) {
+        i2c_txn_t *t = queue_head[p];
+        if (t) {
+            queue_head[p] = t->next;
+            if (!queue_head[p]) queue_tail[p] = NULL;
+            return t;
+        }
+    }
+    return NULL;
+}
+
+// Duração no fio: endereço, prefixo e escrita; a leitura repete o endereço
+static uint32_t txn_us(const i2c_txn_t *t) {
+    uint32_t bytes = 1 + (t->prefix >= 0) + t->tx_len + (t->rx_len ? 1 + t->rx_len : 0);
+    return (uint32_t)((uint64_t)bytes * 9 * 1000000 / bus->baudrate) + TXN_OVERHEAD_US;
+}
+
+static void start_next(void) {
+    current = queue_pop();
+    if (!current) return;
+    uint32_t wait = time_us_32() - current->queued_us;
+    i2c_dev_stats_t *s = &i2c_bus_stats[current->dev];
+    if (wait > s->wait_max_us) s->wait_max_us = wait;
+    hardware_alarm_set_target(alarm_num, time_us_64() + txn_us(current));
+}
+
+// STOP da transação atual: o dispositivo responde e a próxima começa
+static void txn_done(uint alarm) {
+    i2c_txn_t *t = current;
+    bool ok = false;
+    for (int i = 0; i < device_count; i++) {
+        if (devices[i].addr == t->addr) {
+            ok = devices[i].device(t->prefix, t->tx, t->tx_len, t->rx, t->rx_len);
+            break;
+        }
+    }
+
+    uint32_t lat = time_us_32() - t->queued_us;
+    i2c_dev_stats_t *s = &i2c_bus_stats[t->dev];
+    s->txns++;
+    if (!ok) s->errors++;
+    if (lat > s->lat_max_us) s->lat_max_us = lat;
+    s->lat_avg_us = s->lat_avg_us ? s->lat_avg_us + ((int32_t)(lat - s->lat_avg_us) >> 4) : lat;
+
+    t->ok = ok;
+    t->busy = false;
+    if (t->done) t->done(t, ok);
+    start_next();
+}
+
+void i2c_bus_init(i2c_inst_t *i2c) {
+    bus = i2c;
+    if (alarm_num < 0) alarm_num = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm_num, txn_done);
+}
+
+bool i2c_bus_submit(i2c_txn_t *txn) {
+    if (txn->busy) return false;
+    txn->busy = true;
+    txn->next = NULL;
+    txn->queued_us = time_us_32();
+
+    uint8_t p = txn->prio < I2C_PRIO_COUNT ? txn->prio : I2C_PRIO_LOW;
+    if (queue_tail[p]) queue_tail[p]->next = txn;
+    else queue_head[p] = txn;
+    queue_tail[p] = txn;
+    if (!current) start_next();
+    return true;
+}
+
+bool i2c_bus_transfer_blocking(i2c_txn_t *txn) {
+    if (!i2c_bus_submit(txn)) return false;
+    while (txn->busy) tight_loop_contents();
+    return txn->ok;
+}
+
+bool i2c_bus_idle(void) {
+    return current == NULL;
+}
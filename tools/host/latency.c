@@ -0,0 +1,327 @@
+/**
+ * Latência de ponta a ponta no computador: degrau de temperatura no diodo
+ * até os dígitos novos no painel, pelo código do firmware
+ *
+ * O degrau entra pela tensão do ADC0 (hardware/adc.h do host) e passa por
+ * acq_sar.c, diag.c, supply.c, sensor.c, filter.c e rate.c na sequência do
+ * callback de amostragem de main.c; o loop principal, acordado pelo timer,
+ * redesenha a tela de status na taxa da tela com screens.c, bigfont.c e
+ * ssd1306.c. As transações saem pelo barramento do host (i2c_bus.c), com o
+ * tempo de cada uma no clock do I2C, para um modelo do SSD1306 que monta a
+ * GDDRAM (endereçamento horizontal, 0x21/0x22) e lê de volta o número
+ * grande ao fim de cada página.
+ *
+ * Compilado e executado por tools/latency_model.py. Argumentos chave=valor
+ * (ver options[]); imprime, por tentativa, os tempos do degrau até a
+ * primeira transação depois da qual o painel mostra outro valor e até a que
+ * mostra o valor final (a menos de um passo de exibição), em µs (-1 =
+ * nunca).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+#include "ssd1306.h"
+#include "seg7_font.h"
+#include "blit.h"
+#include "screens.h"
+#include "alarms.h"
+#include "phase.h"
+#include "supply.h"
+#include "acq.h"
+#include "sensor.h"
+#include "diag.h"
+#include "filter.h"
+#include "rate.h"
+#include "plant.h"
+#include "app.h"
+
+#define TEMP_LOW_C      40.0f   // LED e alarme de temperatura baixa (main.c)
+#define TEMP_LOW_HYST_C 0.5f
+#define TEMP_X_RIGHT    96      // temp_field da tela de status (screens.c)
+#define TEMP_PAGE       1
+#define WAKE_US         20      // Callback do timer até o loop acordar
+#define DRAW_US         400     // Formatação no M0+ (printf de float), sem custo aqui
+#define SETTLE_SAMPLES  200     // Regime antes de cada degrau
+#define STEP_SAMPLES    400     // Limite de espera pelo valor final
+
+static struct {
+    double trials, from, to, adaptive, noise, low, seed;
+    double sample_ms, sample_low_ms, output_ms, display_ms, display_low_ms;
+} opt = {
+    .trials = 500, .from = 30, .to = 60, .noise = 1, .seed = 1,
+    .sample_ms = 500, .sample_low_ms = 2000, .output_ms = 500,
+    .display_ms = 1000, .display_low_ms = 10000,
+};
+
+static const struct {
+    const char *name;
+    double *d;
+} options[] = {
+    { "trials", &opt.trials },          { "from", &opt.from },
+    { "to", &opt.to },                  { "adaptive", &opt.adaptive },
+    { "noise", &opt.noise },            { "low", &opt.low },
+    { "seed", &opt.seed },
+    // Taxas de main.c (lidas dos fontes por tools/latency_model.py)
+    { "sample", &opt.sample_ms },       { "sample_low", &opt.sample_low_ms },
+    { "output", &opt.output_ms },       { "display", &opt.display_ms },
+    { "display_low", &opt.display_low_ms },
+};
+
+// Estado compartilhado com as telas (app.h), definido em main.c no firmware
+bool show_fahrenheit = false;
+float raw_temp = 0.0f;
+float filtered_temp = 0.0f;
+float voltage = 0.0f;
+uint32_t adc_raw = 0;
+uint32_t sample_count = 0;
+
+float celsius_to_fahrenheit(float celsius) {
+    return (celsius * 9.0f / 5.0f) + 32.0f;
+}
+
+// phase.c grava na flash: só o estado lido pela tela da fase
+phase_state_t phase = { .peak = INT16_MIN };
+
+const char *phase_name(phase_id_t id) {
+    return "MESOFILA";
+}
+
+/* SENSOR E CALLBACK DE AMOSTRAGEM */
+
+static float probe_c;                   // Temperatura no diodo
+static uint32_t rng;
+static int sample_alarm;
+static uint64_t next_sample_us;
+static rate_dec_t output_dec;
+static acq_sample_t last_sample;
+static bool sensor_valid = false;
+static bool temp_low = false;
+
+// Ruído aproximadamente gaussiano (soma de 4 uniformes, desvio 1), como acq_sim.c
+static float noise(void) {
+    float sum = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        sum += (float)rng * (1.0f / 4294967296.0f);
+    }
+    return (sum - 2.0f) * 1.7320508f;
+}
+
+static uint32_t period_ms(void) {
+    return (uint32_t)(supply.low ? opt.sample_low_ms : opt.sample_ms);
+}
+
+// Mesma sequência de adc_timer_callback() em main.c
+static void sample_callback(uint alarm) {
+    // 1. Tensão do diodo e alimentação na mesma rodada do ADC
+    uint32_t p = period_ms();
+    float lsb = ADC_VREF / ADC_RANGE;
+    host_adc_set(ADC_NUM, PLANT_DIODE_V0 + PLANT_DIODE_K * probe_c + (float)opt.noise * lsb * noise());
+    acq_sample_t sample;
+    if (acq_sar.read(&sample)) {
+        adc_raw = sample.code;
+        if (diag_check(sample.code, acq_sar.bits)) {
+            last_sample = sample;
+            voltage = sample.voltage;
+            sensor_valid = true;
+        }
+    } else {
+        diag_no_data(false);
+    }
+    supply_update(adc_read() * ADC_VREF / ADC_RANGE, p);
+
+    next_sample_us += p * 1000ull;
+    hardware_alarm_set_target(sample_alarm, next_sample_us);
+    if (diag_fault() || !sensor_valid) {
+        screens_notify(DATA_TEMP | DATA_DIAG);
+        return;
+    }
+
+    // 2. Temperatura e filtro
+    raw_temp = sensor_diode.to_celsius(&last_sample, &acq_sar);
+    filtered_temp = opt.adaptive ? filter_adaptive(raw_temp) : filter_moving_average(raw_temp);
+    sample_count++;
+
+    // 3. Saída decimada: alarme de temperatura baixa e aviso às telas
+    if (rate_dec_add(&output_dec, filtered_temp, p)) {
+        float out = output_dec.mean;
+        if (out < TEMP_LOW_C) temp_low = true;
+        else if (out >= TEMP_LOW_C + TEMP_LOW_HYST_C) temp_low = false;
+        alarm_set(ALARM_TEMP_LOW, temp_low);
+        screens_notify(DATA_TEMP | DATA_DIAG | DATA_BUS);
+    }
+}
+
+/* MODELO DO SSD1306 */
+
+static uint8_t gddram[SSD1306_BUF_LEN];
+static uint8_t col0, col1 = SSD1306_WIDTH - 1, page0, page1 = SSD1306_NUM_PAGES - 1;
+static uint8_t col, page;
+static uint8_t cmd_args[256];           // Argumentos de cada comando usado
+
+// Número grande da GDDRAM, casando os glifos a partir da direita
+static void decode(char *text, size_t size) {
+    char rev[16];
+    size_t n = 0;
+    int x = TEMP_X_RIGHT;
+    while (x > 0 && n < sizeof(rev)) {
+        size_t k = 0;
+        for (; seg7_chars[k]; k++) {
+            int w = seg7_width[k];
+            if (seg7_chars[k] == ' ' || x - w < 0) continue;
+            const uint8_t *strip = seg7_strips + seg7_offset[k];
+            if (!memcmp(gddram + TEMP_PAGE * SSD1306_WIDTH + x - w, strip, w) &&
+                !memcmp(gddram + (TEMP_PAGE + 1) * SSD1306_WIDTH + x - w, strip + w, w)) break;
+        }
+        if (!seg7_chars[k]) break;
+        rev[n++] = seg7_chars[k];
+        x -= seg7_width[k];
+    }
+    size_t i = 0;
+    for (; i < n && i + 1 < size; i++) text[i] = rev[n - 1 - i];
+    text[i] = '\0';
+}
+
+static char shown_before[16];           // Painel antes do degrau
+static float final_value;
+static bool measuring = false;
+static uint64_t step_us;
+static int64_t first_change_us, first_final_us;
+
+static void panel_changed(void) {
+    if (!measuring) return;
+    char text[16];
+    decode(text, sizeof(text));
+    uint64_t t = time_us_64() - step_us;
+    if (first_change_us < 0 && strcmp(text, shown_before) != 0) first_change_us = t;
+    char *end;
+    float v = strtof(text, &end);
+    if (first_final_us < 0 && *text && !*end && fabsf(v - final_value) < 0.1f + 1e-4f) first_final_us = t;
+}
+
+static bool ssd1306_device(int16_t prefix, const uint8_t *tx, uint16_t tx_len, uint8_t *rx, uint16_t rx_len) {
+    if (prefix == 0x40) {
+        // Dados: coluna a coluna na janela, passando à página seguinte
+        for (uint16_t i = 0; i < tx_len; i++) {
+            gddram[page * SSD1306_WIDTH + col] = tx[i];
+            if (col++ == col1) {
+                col = col0;
+                page = page == page1 ? page0 : page + 1;
+            }
+        }
+        panel_changed();
+        return true;
+    }
+    // Comandos (0x80: um só; 0x00: a lista inteira)
+    for (uint16_t i = 0; i < tx_len; i += 1 + cmd_args[tx[i]]) {
+        if (i + 2 < tx_len && tx[i] == 0x21) col = col0 = tx[i + 1], col1 = tx[i + 2];
+        if (i + 2 < tx_len && tx[i] == 0x22) page = page0 = tx[i + 1], page1 = tx[i + 2];
+    }
+    return true;
+}
+
+/* LOOP PRINCIPAL */
+
+static rate_tick_t display_tick;
+
+// Uma volta do loop de main.c depois de cada amostra (acordado pelo timer)
+static void run_samples(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t wake = next_sample_us + WAKE_US;
+        if (wake > time_us_64()) host_run_until(wake);
+        display_tick.period_ms = (uint32_t)(supply.low ? opt.display_low_ms : opt.display_ms);
+        if (rate_tick_due(&display_tick, (uint32_t)(time_us_64() / 1000))) {
+            host_run_until(time_us_64() + DRAW_US);
+            screens_update();
+        }
+        if (measuring && first_final_us >= 0) break;
+    }
+}
+
+static void parse(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        char *eq = strchr(argv[i], '=');
+        size_t n = eq ? (size_t)(eq - argv[i]) : 0;
+        size_t k = 0;
+        for (; eq && k < sizeof(options) / sizeof(options[0]); k++) {
+            if (strlen(options[k].name) == n && !strncmp(options[k].name, argv[i], n)) break;
+        }
+        if (!eq || k == sizeof(options) / sizeof(options[0])) {
+            fprintf(stderr, "opção desconhecida: %s\n", argv[i]);
+            exit(2);
+        }
+        *options[k].d = atof(eq + 1);
+    }
+}
+
+int main(int argc, char **argv) {
+    parse(argc, argv);
+    rng = (uint32_t)opt.seed * 2654435761u | 1;
+    static const uint8_t args[][2] = {
+        { 0x20, 1 }, { 0x21, 2 }, { 0x22, 2 }, { 0x81, 1 }, { 0x8D, 1 }, { 0xA8, 1 },
+        { 0xD3, 1 }, { 0xD5, 1 }, { 0xD9, 1 }, { 0xDA, 1 }, { 0xDB, 1 },
+    };
+    for (size_t i = 0; i < sizeof(args) / sizeof(args[0]); i++) cmd_args[args[i][0]] = args[i][1];
+
+    // Alimentação: USB, ou bateria abaixo de SUPPLY_LOW_V com --low-power
+    host_gpio_set(VBUS_SENSE_PIN, !opt.low);
+    host_adc_set(VSYS_ADC_NUM, (opt.low ? SUPPLY_LOW_V - 0.2f : 5.0f) / VSYS_DIVIDER);
+
+    // Inicialização na ordem de main()
+    i2c_init(i2c_default, SSD1306_I2C_CLK * 1000);
+    i2c_bus_init(i2c_default);
+    host_i2c_attach(SSD1306_I2C_ADDR, ssd1306_device);
+    supply_init();
+    acq_sar.init();
+    adc_set_round_robin(acq_sar.adc_channels | (1u << VSYS_ADC_NUM));
+    SSD1306_init();
+    blit_dma_init();
+    output_dec = (rate_dec_t)RATE_DEC((uint32_t)opt.output_ms);
+    display_tick = (rate_tick_t)RATE_TICK((uint32_t)opt.display_ms);
+    sample_alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(sample_alarm, sample_callback);
+    next_sample_us = time_us_64() + period_ms() * 1000ull;
+    hardware_alarm_set_target(sample_alarm, next_sample_us);
+
+    // Valor final: a média da saída do filtro assentado na temperatura
+    // nova, no passo da tela. O ruído fica: um código constante é sensor
+    // travado para diag.c
+    probe_c = (float)opt.to;
+    run_samples(2 * STEP_SAMPLES);
+    double sum = 0;
+    for (int i = 0; i < SETTLE_SAMPLES; i++) {
+        run_samples(1);
+        sum += filtered_temp;
+    }
+    final_value = roundf((float)(sum / SETTLE_SAMPLES) * 10.0f) / 10.0f;
+
+    for (int trial = 0; trial < (int)opt.trials; trial++) {
+        // Regime na temperatura de partida; o número de amostras varia a
+        // fase do redesenho em relação ao degrau
+        probe_c = (float)opt.from;
+        run_samples(SETTLE_SAMPLES + rng % 8);
+        decode(shown_before, sizeof(shown_before));
+
+        // Degrau em fase qualquer depois da última amostra: até a próxima o
+        // ADC não é lido, então ele já pode entrar agora
+        rng ^= rng << 13, rng ^= rng >> 17, rng ^= rng << 5;
+        step_us = next_sample_us - (uint64_t)((rng >> 8) * (1.0 / (1 << 24)) * period_ms() * 1000.0);
+        probe_c = (float)opt.to;
+        first_change_us = first_final_us = -1;
+        measuring = true;
+        run_samples(STEP_SAMPLES);
+        measuring = false;
+        printf("%lld %lld\n", (long long)first_change_us, (long long)first_final_us);
+    }
+    return 0;
+}
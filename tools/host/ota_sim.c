@@ -0,0 +1,105 @@
+/**
+ * Atualização pela USB no computador: ota.c, link.c e crc.c sobre a flash
+ * do host (hardware/flash.h), comandados por tools/ota.py sim
+ *
+ * Uma linha por comando na entrada padrão; a resposta são as confirmações
+ * do ota.c (LOG "OTA <tipo> <estado> <valor>", uma por linha) e uma linha
+ * "." no fim:
+ *   load ARQUIVO   flash com a imagem no início e o resto apagado
+ *   save ARQUIVO   grava a flash inteira no arquivo
+ *   cut N          a energia cai na N-ésima operação da flash a partir daqui
+ *                  (-1 = nunca)
+ *   frame HEX      bytes recebidos pela USB; o loop principal roda até
+ *                  consumi-los (link_poll e ota_poll, como em main.c)
+ * Quando o aparelho desliga (queda de energia ou o reset pedido pelo
+ * ota_install) sai "X corte|reset <operações>" e os comandos seguintes
+ * recusam quadros: um aparelho reiniciado é um processo novo.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "link.h"
+#include "ota.h"
+
+static jmp_buf off_jmp;
+static const char *off_why = NULL;
+
+// Confirmações da atualização; os outros registros do log são descartados
+static void log_record(const char *fmt, const uint32_t *args, uint32_t nargs) {
+    if (strncmp(fmt, "OTA ", 4) == 0 && nargs == 3) {
+        printf("%c %s %u\n", (char)args[0], (const char *)(uintptr_t)args[1], args[2]);
+    }
+}
+
+static void power_off(const char *why) {
+    off_why = why;
+    longjmp(off_jmp, 1);
+}
+
+static void run_frame(const char *hex) {
+    uint8_t buf[2 * LINK_PAYLOAD_MAX];
+    size_t n = 0;
+    unsigned b;
+    while (n < sizeof(buf) && sscanf(hex + 2 * n, "%2x", &b) == 1) buf[n++] = b;
+    if (off_why) return;
+    if (setjmp(off_jmp)) {
+        printf("X %s %u\n", off_why, host_flash_ops);
+        return;
+    }
+    host_stdin_push(buf, n);
+    do {
+        link_poll();
+        ota_poll();
+    } while (ota_busy());
+}
+
+static void load(const char *path) {
+    memset(host_flash, 0xFF, sizeof(host_flash));
+    FILE *f = fopen(path, "rb");
+    if (!f || fread(host_flash, 1, sizeof(host_flash), f) == 0) {
+        fprintf(stderr, "imagem ilegível: %s\n", path);
+        exit(2);
+    }
+    fclose(f);
+}
+
+static void save(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f || fwrite(host_flash, 1, sizeof(host_flash), f) != sizeof(host_flash)) {
+        fprintf(stderr, "não foi possível gravar %s\n", path);
+        exit(2);
+    }
+    fclose(f);
+}
+
+int main(void) {
+    static char line[4 * LINK_PAYLOAD_MAX + 64];
+    host_log = log_record;
+    host_power_off = power_off;
+    memset(host_flash, 0xFF, sizeof(host_flash));
+
+    while (fgets(line, sizeof(line), stdin)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char *arg = strchr(line, ' ');
+        if (arg) *arg++ = '\0';
+        else arg = line + strlen(line);
+
+        if (!strcmp(line, "load")) load(arg);
+        else if (!strcmp(line, "save")) save(arg);
+        else if (!strcmp(line, "cut")) {
+            host_flash_cut_at = atoi(arg);
+            host_flash_ops = 0;
+        } else if (!strcmp(line, "frame")) run_frame(arg);
+        else {
+            fprintf(stderr, "comando desconhecido: %s\n", line);
+            return 2;
+        }
+        puts(".");
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * Substitutos do Pico SDK para rodar módulos do firmware no computador
+ * (tools/plant_sim.py, tools/latency_model.py): só o que esses módulos
+ * usam, com um relógio virtual e alarmes de hardware disparados por
+ * host_run_until() (host.c)
+ */
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PICO_ON_DEVICE  0
+
+#define _u(x)           x ## u
+#define __aligned(x)    __attribute__((aligned(x)))
+#define __no_inline_not_in_flash_func(f) __attribute__((noinline)) f
+
+#define PICO_ERROR_TIMEOUT  (-1)
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+enum { GPIO_FUNC_PWM = 4 };
+
+uint64_t time_us_64(void);
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+static inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline void gpio_set_function(uint gpio, int fn) { (void)gpio; (void)fn; }
+
+// Avança o relógio virtual até t_us, disparando os alarmes vencidos
+void host_run_until(uint64_t t_us);
+// Espera ocupada: o tempo só passa até o próximo alarme (que a encerra)
+void host_idle(void);
+uint16_t host_pwm_level(uint gpio);
+
+static inline void tight_loop_contents(void) { host_idle(); }
+static inline void sleep_ms(uint32_t ms) { host_run_until(time_us_64() + ms * 1000ull); }
+
+// Entrada da serial: bytes colocados por host_stdin_push(), lidos sem espera
+int getchar_timeout_us(uint32_t timeout_us);
+static inline void stdio_flush(void) {}
+void host_stdin_push(const uint8_t *data, size_t len);
+
+// Registros do LOG (o executável não é PIE: os ponteiros de 32 bits do log
+// binário, como o formato e os %s, são os endereços)
+extern void (*host_log)(const char *fmt, const uint32_t *args, uint32_t nargs);
+
+// O aparelho desliga (queda de energia na flash ou reset pelo SCB): não
+// retorna (longjmp do programa); sem ele, o programa aborta
+extern void (*host_power_off)(const char *why);
+
+#endif
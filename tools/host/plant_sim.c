@@ -0,0 +1,183 @@
+/**
+ * Malha fechada no computador: leira simulada (plant.c) -> backend
+ * acq_sim -> lei do diodo (sensor.c) -> filtro -> decimação (rate.c) ->
+ * alarme do LED e controle do soprador (control.c), em tempo virtual
+ *
+ * Compilado e executado por tools/plant_sim.py. Argumentos chave=valor (ver
+ * options[]); imprime uma linha de resumo chave=valor e, com trace=N, uma
+ * linha a cada N minutos simulados.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "acq.h"
+#include "sensor.h"
+#include "filter.h"
+#include "control.h"
+#include "plant.h"
+#include "rate.h"
+
+#define SAMPLE_MS       500     // Taxas de main.c
+#define OUTPUT_MS       500
+#define TEMP_LOW_C      40.0f   // LED e alarme de temperatura baixa (main.c)
+#define TEMP_LOW_HYST_C 0.5f
+#define SANITIZE_C      55.0f   // Higienização (horas acima, como phase.c)
+#define OVERHEAT_C      70.0f   // Acima disso a leira perde a atividade
+
+static struct {
+    double days, trace_min, adaptive;
+    double mode, action, setpoint, hysteresis, kp, ki, kd, min_on, min_off;
+    double noise, seed;
+} opt = {
+    .days = 30, .trace_min = 0, .adaptive = 0, .noise = 1.5, .seed = 1,
+};
+
+static const struct {
+    const char *name;
+    double *d;
+    float *f;
+} options[] = {
+    // Simulação e controle
+    { "days", &opt.days, NULL },            { "trace", &opt.trace_min, NULL },
+    { "adaptive", &opt.adaptive, NULL },    { "noise", &opt.noise, NULL },
+    { "seed", &opt.seed, NULL },            { "mode", &opt.mode, NULL },
+    { "action", &opt.action, NULL },        { "setpoint", &opt.setpoint, NULL },
+    { "hysteresis", &opt.hysteresis, NULL },
+    { "kp", &opt.kp, NULL },                { "ki", &opt.ki, NULL },
+    { "kd", &opt.kd, NULL },                { "min_on", &opt.min_on, NULL },
+    { "min_off", &opt.min_off, NULL },
+    // Leira (plant_params_t)
+    { "heat_max", NULL, &acq_sim_params.heat_max },
+    { "t_min", NULL, &acq_sim_params.t_min },
+    { "t_opt", NULL, &acq_sim_params.t_opt },
+    { "t_max", NULL, &acq_sim_params.t_max },
+    { "o2_passive", NULL, &acq_sim_params.o2_passive },
+    { "o2_k", NULL, &acq_sim_params.o2_k },
+    { "substrate_h", NULL, &acq_sim_params.substrate_h },
+    { "loss", NULL, &acq_sim_params.loss },
+    { "aeration", NULL, &acq_sim_params.aeration },
+    { "ambient", NULL, &acq_sim_params.ambient },
+    { "ambient_amp", NULL, &acq_sim_params.ambient_amp },
+    { "probe_tau", NULL, &acq_sim_params.probe_tau_s },
+};
+
+// Alimentação pelo USB (supply.on_battery falso): supply_compensate() não
+// corrige nada (supply.c não entra nesta simulação)
+float supply_compensate(float diode_v) {
+    return diode_v;
+}
+
+static void parse(int argc, char **argv) {
+    // Padrões do controle: os de control.c
+    opt.mode = control_config.mode;
+    opt.action = control_config.action;
+    opt.setpoint = control_config.setpoint;
+    opt.hysteresis = control_config.hysteresis;
+    opt.kp = control_config.kp;
+    opt.ki = control_config.ki;
+    opt.kd = control_config.kd;
+    opt.min_on = control_config.min_on_s;
+    opt.min_off = control_config.min_off_s;
+
+    for (int i = 1; i < argc; i++) {
+        char *eq = strchr(argv[i], '=');
+        size_t n = eq ? (size_t)(eq - argv[i]) : 0;
+        size_t k = 0;
+        for (; eq && k < sizeof(options) / sizeof(options[0]); k++) {
+            if (strlen(options[k].name) == n && !strncmp(options[k].name, argv[i], n)) break;
+        }
+        if (!eq || k == sizeof(options) / sizeof(options[0])) {
+            fprintf(stderr, "opção desconhecida: %s\n", argv[i]);
+            exit(2);
+        }
+        double v = atof(eq + 1);
+        if (options[k].d) *options[k].d = v;
+        else *options[k].f = (float)v;
+    }
+}
+
+int main(int argc, char **argv) {
+    parse(argc, argv);
+    acq_sim_noise_lsb = (float)opt.noise;
+    acq_sim_seed = (uint32_t)opt.seed;
+
+    const acq_backend_t *acq = &acq_sim;
+    acq->init();
+    control_init();
+    control_config_t cfg = {
+        .mode = (uint8_t)opt.mode, .action = (uint8_t)opt.action,
+        .setpoint = (float)opt.setpoint, .hysteresis = (float)opt.hysteresis,
+        .kp = (float)opt.kp, .ki = (float)opt.ki, .kd = (float)opt.kd,
+        .min_on_s = (uint16_t)opt.min_on, .min_off_s = (uint16_t)opt.min_off,
+    };
+    control_configure(&cfg);
+
+    const plant_t *pl = &acq_sim_plant;
+    uint64_t samples = (uint64_t)(opt.days * 86400.0 * 1000.0 / SAMPLE_MS);
+    uint64_t trace_every = (uint64_t)(opt.trace_min * 60000.0 / SAMPLE_MS);
+    const double dt_h = SAMPLE_MS / 3600000.0;
+
+    // Resumo
+    double h_sanitize = 0, h_overheat = 0, duty = 0, err2 = 0, ctl2 = 0, ctl_h = 0;
+    double first_sanitize_h = NAN;
+    float core_max = -100.0f;
+    uint32_t led_changes = 0, blower_starts = 0;
+    bool led = false, led_now = false, blower = false, reached = false;
+
+    if (trace_every) puts("# horas nucleo sonda filtrada saida ambiente substrato atividade led");
+    for (uint64_t n = 1; n <= samples; n++) {
+        host_run_until(n * SAMPLE_MS * 1000ull);    // Laço de controle (100 ms)
+
+        // Mesma sequência do callback do timer de main.c
+        acq_sample_t s;
+        if (!acq->read(&s)) continue;
+        float raw = sensor_diode.to_celsius(&s, acq);
+        float filtered = opt.adaptive ? filter_adaptive(raw) : filter_moving_average(raw);
+        static rate_dec_t output_dec = RATE_DEC(OUTPUT_MS);
+        if (rate_dec_add(&output_dec, filtered, SAMPLE_MS)) {
+            if (output_dec.mean < TEMP_LOW_C) led_now = true;
+            else if (output_dec.mean >= TEMP_LOW_C + TEMP_LOW_HYST_C) led_now = false;
+            control_set_input((int32_t)(output_dec.mean * 100.0f), true);
+        }
+
+        led_changes += led_now != led && n > 1;
+        led = led_now;
+        uint16_t out = host_pwm_level(CONTROL_PIN);
+        blower_starts += out && !blower;
+        blower = out != 0;
+        duty += out * (1.0 / CONTROL_OUT_MAX) * dt_h;
+
+        float err = filtered - pl->core;
+        err2 += err * err;
+        if (pl->core > core_max) core_max = pl->core;
+        if (pl->core >= SANITIZE_C) {
+            h_sanitize += dt_h;
+            if (isnan(first_sanitize_h)) first_sanitize_h = pl->hours;
+        }
+        if (pl->core >= OVERHEAT_C) h_overheat += dt_h;
+        // Qualidade do controle: quanto o núcleo passa do alvo no sentido
+        // que a saída corrige (acima, resfriando), depois de atingi-lo
+        float e = (pl->core - cfg.setpoint) * (cfg.action == CONTROL_HEAT ? -1.0f : 1.0f);
+        if (e >= 0.0f) reached = true;
+        if (reached) {
+            if (e > 0.0f) ctl2 += e * e * dt_h;
+            ctl_h += dt_h;
+        }
+
+        if (trace_every && n % trace_every == 0) {
+            printf("%.3f %.2f %.2f %.2f %u %.2f %.4f %.3f %d\n", pl->hours, pl->core, pl->probe,
+                   filtered, out, plant_ambient(pl), pl->substrate, pl->activity, led);
+        }
+    }
+
+    double hours = samples * dt_h;
+    printf("dias=%g max=%.2f h55=%.1f h70=%.1f chegada55=%.1f erro_rms=%.3f "
+           "excesso_rms=%.2f soprador=%.1f%% partidas=%u led=%u substrato=%.3f\n",
+           opt.days, core_max, h_sanitize, h_overheat, first_sanitize_h, sqrt(err2 / samples),
+           ctl_h > 0 ? sqrt(ctl2 / ctl_h) : NAN,
+           100.0 * duty / hours, blower_starts, led_changes, pl->substrate);
+    return 0;
+}
@@ -0,0 +1,44 @@
+"""
+Compilação no computador de módulos do firmware com gcc e os substitutos do
+SDK de tools/host/ (simuladores e testes de tools/).
+
+Os headers gerados no build do firmware (ntc_lut.h, screen_templates.h) são
+gerados aqui pelos mesmos scripts, em build_dir/generated. O executável só é
+refeito quando algum fonte, header ou gerador mudou.
+"""
+
+import os
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HOST = os.path.join(ROOT, "tools", "host")
+TOOLS = os.path.join(ROOT, "tools")
+
+
+def _generate(gen):
+    os.makedirs(gen, exist_ok=True)
+    subprocess.check_call([sys.executable, os.path.join(TOOLS, "gen_ntc_lut.py"),
+                           os.path.join(gen, "ntc_lut.h")])
+    subprocess.check_call([sys.executable, os.path.join(TOOLS, "gen_templates.py"),
+                           os.path.join(ROOT, "screens.layout"), os.path.join(ROOT, "ssd1306_font.h"),
+                           os.path.join(ROOT, "icons.h"), os.path.join(gen, "screen_templates.h")])
+
+
+def build(name, sources, build_dir, defines=()):
+    """Compila name a partir de sources (caminhos relativos à raiz do
+    repositório) se algo mudou; devolve o caminho do executável."""
+    exe = os.path.join(build_dir, name)
+    gen = os.path.join(build_dir, "generated")
+    srcs = [os.path.join(ROOT, s) for s in sources]
+    deps = srcs + [os.path.join(TOOLS, f) for f in ("host_build.py", "gen_ntc_lut.py", "gen_templates.py")]
+    deps += [os.path.join(d, f) for d, _, files in os.walk(HOST) for f in files if f.endswith(".h")]
+    deps += [os.path.join(ROOT, f) for f in os.listdir(ROOT) if f.endswith(".h") or f == "screens.layout"]
+    if os.path.exists(exe) and os.path.getmtime(exe) >= max(map(os.path.getmtime, deps)):
+        return exe
+    _generate(gen)
+    # Sem PIE: o LOG guarda ponteiros em 32 bits (tools/host/host.c os lê de volta)
+    subprocess.check_call([os.environ.get("CC", "gcc"), "-O2", "-std=gnu11", "-Wall", "-no-pie",
+                           "-Wno-unused-parameter", *("-D" + d for d in defines),
+                           "-I" + HOST, "-I" + ROOT, "-I" + gen, *srcs, "-lm", "-o", exe])
+    return exe
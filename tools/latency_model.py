@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+Latência de ponta a ponta no computador: degrau de temperatura no sensor
+até os dígitos novos no painel OLED, medida no código do firmware.
+
+Compila, com gcc e os substitutos do SDK de tools/host/, o caminho do
+firmware entre o ADC e o painel (acq_sar.c, diag.c, supply.c, sensor.c,
+filter.c, rate.c, screens.c, bigfont.c, ssd1306.c e os módulos das telas)
+junto com tools/host/latency.c, que injeta o degrau na tensão do ADC0 e
+repete a sequência do callback de amostragem e do loop principal de main.c
+em tempo virtual:
+  - timer de amostragem (SAMPLE_MS, ou SAMPLE_LOW_MS com bateria fraca) com
+    o degrau em fase aleatória em relação a ele;
+  - filtro: a média móvel ou o adaptativo de filter.c;
+  - saída do filtro decimada a OUTPUT_MS (avisa a tela de dados novos) e
+    redesenho da tela de status quando o display_tick (DISPLAY_MS, ou
+    DISPLAY_LOW_MS) venceu;
+  - transações de render_dirty() pelo barramento do host
+    (tools/host/i2c_bus.c), cada uma com o tempo dos seus bytes a
+    SSD1306_I2C_CLK kHz, para um modelo do SSD1306 que monta a GDDRAM e lê
+    de volta o número grande (glifos de seg7_font.h) ao fim de cada página.
+
+As taxas são lidas de main.c e ssd1306.h. Para cada fase mede o tempo do
+degrau até a primeira transação depois da qual o painel mostra um valor
+diferente e até a que mostra o valor final (a menos de um passo de
+exibição), e imprime a distribuição. Com --noise 0 o código do ADC fica
+constante no regime e diag.c marca o sensor como travado ("---.-").
+
+Uso:
+    tools/latency_model.py [--trials 500] [--from 30] [--to 60]
+                           [--filter fixed|adaptive] [--noise 1]
+                           [--low-power] [--seed 1]
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+from host_build import ROOT, build
+
+SOURCES = ["tools/host/latency.c", "tools/host/host.c", "tools/host/i2c_bus.c", "acq_sar.c", "diag.c",
+           "supply.c", "sensor.c", "filter.c", "rate.c", "lerp.c", "screens.c", "ssd1306.c",
+           "bigfont.c", "blit.c", "alarms.c", "history.c", "predict.c"]
+
+
+def read_define(path, name):
+    m = re.search(rf"#define\s+{name}\s+(\S+)", open(os.path.join(ROOT, path), encoding="utf-8").read())
+    return float(m.group(1).rstrip("f"))
+
+
+def summary(name, values):
+    values = sorted(v for v in values if v >= 0)
+    if not values:
+        print(f"{name:22s} nunca")
+        return
+    q = lambda f: values[min(int(f * len(values)), len(values) - 1)] / 1000.0
+    print(f"{name:22s} mín {q(0):8.1f}  mediana {q(0.5):8.1f}  p90 {q(0.9):8.1f}  "
+          f"máx {values[-1] / 1000.0:8.1f} ms")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("--trials", type=int, default=500)
+    ap.add_argument("--from", dest="t0", type=float, default=30.0)
+    ap.add_argument("--to", dest="t1", type=float, default=60.0)
+    ap.add_argument("--filter", choices=("fixed", "adaptive"), default="fixed")
+    ap.add_argument("--noise", type=float, default=1.0, help="ruído do ADC (LSB rms)")
+    ap.add_argument("--low-power", action="store_true")
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--build-dir", default=os.path.join(ROOT, "build", "latency"))
+    args = ap.parse_args()
+
+    rates = {key: read_define("main.c", name) for key, name in
+             (("sample", "SAMPLE_MS"), ("sample_low", "SAMPLE_LOW_MS"), ("output", "OUTPUT_MS"),
+              ("display", "DISPLAY_MS"), ("display_low", "DISPLAY_LOW_MS"))}
+    exe = build("latency", SOURCES, args.build_dir)
+    params = [f"trials={args.trials}", f"from={args.t0}", f"to={args.t1}",
+              f"adaptive={int(args.filter == 'adaptive')}", f"noise={args.noise}",
+              f"low={int(args.low_power)}", f"seed={args.seed}"]
+    params += [f"{k}={v:g}" for k, v in rates.items()]
+    out = subprocess.run([exe, *params], check=True, capture_output=True, text=True).stdout
+    results = [tuple(int(v) for v in line.split()) for line in out.splitlines()]
+
+    print(f"degrau {args.t0:g} -> {args.t1:g} C, filtro {args.filter}, ruído {args.noise:g} LSB, "
+          f"{args.trials} fases{' (bateria fraca)' if args.low_power else ''}")
+    summary("primeira mudança", [r[0] for r in results])
+    summary("valor final", [r[1] for r in results])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
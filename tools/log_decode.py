@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""
+Decodifica o log binário do firmware (log.c) com o ELF do mesmo build.
+
+Cada quadro da serial é um registro em COBS terminado em 0x00:
+    [id | nargs << 16 | seq << 24] [instante em µs] [argumentos...] [CRC-16]
+O CRC-16 é o CCITT-FALSE (0x1021, semente 0xFFFF) das palavras do registro;
+quadros com CRC errado são contados e descartados.
+O id é o endereço da string de formato na seção .log_fmt do ELF (não
+carregada na flash). Os argumentos são convertidos pelo tipo de cada
+especificador: %d/%i com sinal, %u/%x/%c sem sinal, %f/%e/%g como float de
+32 bits e %s como ponteiro para uma string constante, lida das seções do ELF.
+Trechos que não são quadros válidos (a saída de texto dos benchmarks, por
+exemplo) são repassados como texto.
+
+Uso:
+    stty -F /dev/ttyACM0 raw
+    tools/log_decode.py build/main.elf < /dev/ttyACM0
+    tools/log_decode.py build/main.elf captura.bin
+"""
+
+import argparse
+import binascii
+import re
+import struct
+import sys
+
+SPEC = re.compile(r"%([-+ #0]*)(\d+)?(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXeEfgGcsp%])")
+SHF_ALLOC = 0x2
+
+
+# --- ELF --------------------------------------------------------------------
+
+class Elf:
+    """Seções de um ELF32 little-endian (o bastante para o RP2040)."""
+
+    def __init__(self, path):
+        data = open(path, "rb").read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            sys.exit(f"{path}: não é um ELF32 little-endian")
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+        raw = []
+        for i in range(shnum):
+            name, typ, flags, addr, off, size, link = struct.unpack_from("<IIIIIII", data, shoff + i * shentsize)
+            raw.append((name, typ, flags, addr, data[off:off + size] if typ != 8 else b"", link))
+        strtab = raw[shstrndx][4]
+        self.sections = {}
+        for name, typ, flags, addr, body, _ in raw:
+            sname = strtab[name:strtab.index(b"\0", name)].decode()
+            self.sections[sname] = (flags, addr, body)
+        self._raw = raw
+
+    def fmt(self, addr):
+        """String de formato no endereço (deslocamento) da .log_fmt."""
+        if ".log_fmt" not in self.sections:
+            sys.exit("ELF sem a seção .log_fmt")
+        _, base, body = self.sections[".log_fmt"]
+        return self._cstr(body, addr - base)
+
+    def string(self, addr):
+        """String constante nas seções carregadas (flash/RAM inicializada)."""
+        for flags, base, body in self.sections.values():
+            if flags & SHF_ALLOC and base <= addr < base + len(body):
+                return self._cstr(body, addr - base)
+        return f"<0x{addr:08x}>"
+
+    def symbols(self):
+        """Símbolos da .symtab: (nome, endereço, tamanho, tipo, vínculo)."""
+        out = []
+        for _, typ, _, _, body, link in self._raw:
+            if typ != 2:                    # SHT_SYMTAB
+                continue
+            names = self._raw[link][4]
+            for off in range(0, len(body), 16):
+                name, value, size, info = struct.unpack_from("<IIIB", body, off)
+                out.append((self._cstr(names, name), value, size, info & 0xF, info >> 4))
+        return out
+
+    @staticmethod
+    def _cstr(body, off):
+        if not 0 <= off < len(body):
+            return None
+        end = body.find(b"\0", off)
+        return body[off:end if end >= 0 else len(body)].decode("utf-8", "replace")
+
+
+# --- Quadros ----------------------------------------------------------------
+
+def cobs_decode(frame):
+    out, i = bytearray(), 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            return None
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def format_record(elf, words):
+    """Texto de um registro, ou None se ele não for válido para este ELF."""
+    header = words[0]
+    nargs = header >> 16 & 0xFF
+    fmt = elf.fmt(header & 0xFFFF)
+    if fmt is None or len(words) != 2 + nargs:
+        return None
+    args = iter(words[2:])
+    parts, pos = [], 0
+    for m in SPEC.finditer(fmt):
+        parts.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            parts.append("%")
+            continue
+        w = next(args, 0)
+        if conv in "di":
+            value = w - (1 << 32) if w & 0x80000000 else w
+        elif conv in "feEgG":
+            value = struct.unpack("<f", struct.pack("<I", w))[0]
+        elif conv == "s":
+            value = elf.string(w)
+        elif conv == "p":
+            value, conv = w, "x"
+        else:
+            value = w
+        spec = "%" + flags + (width or "") + ("." + prec if prec else "") + ("d" if conv == "u" else conv)
+        parts.append(spec % value)
+    parts.append(fmt[pos:])
+    return "".join(parts)
+
+
+class Decoder:
+    def __init__(self, elf, out):
+        self.elf, self.out = elf, out
+        self.seq = None
+        self.corrupted = 0
+        self.t_last, self.t_wraps = None, 0
+
+    def timestamp(self, us):
+        if self.t_last is not None and us < self.t_last:
+            self.t_wraps += 1               # time_us_32() volta a zero a cada 71 min
+        self.t_last = us
+        return (self.t_wraps * (1 << 32) + us) / 1e6
+
+    def frame(self, raw):
+        # Texto antes do primeiro quadro chega sem separador 0x00
+        nl = raw.rfind(b"\n")
+        if nl >= 0:
+            self.out.write(raw[:nl + 1].decode("ascii", "replace"))
+            raw = raw[nl + 1:]
+            if not raw:
+                return
+        data = cobs_decode(raw)
+        text = None
+        if data and len(data) >= 10 and len(data) % 4 == 2:
+            body, crc = data[:-2], int.from_bytes(data[-2:], "little")
+            if binascii.crc_hqx(body, 0xFFFF) == crc:
+                words = struct.unpack(f"<{len(body) // 4}I", body)
+                text = format_record(self.elf, words)
+        if text is None:
+            if all(32 <= c < 127 or c in b"\t\r" for c in raw):
+                # Não é um registro: texto solto (benchmarks, mensagens do SDK)
+                self.out.write(raw.decode("ascii"))
+            else:
+                self.corrupted += 1
+                self.out.write(f"(quadro corrompido, {self.corrupted} no total)\n")
+            return
+        seq = words[0] >> 24
+        if self.seq is not None and seq != (self.seq + 1) & 0xFF:
+            self.out.write(f"(registros perdidos: {(seq - self.seq - 1) & 0xFF})\n")
+        self.seq = seq
+        self.out.write(f"[{self.timestamp(words[1]):12.6f}] {text}\n")
+
+    def feed(self, stream):
+        buf = bytearray()
+        while True:
+            chunk = stream.read(1)
+            if not chunk:
+                break
+            if chunk[0] == 0:
+                self.frame(bytes(buf))
+                buf.clear()
+                self.out.flush()
+            else:
+                buf += chunk
+        if buf:
+            self.out.write(buf.decode("ascii", "replace"))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("elf", help="ELF do build que gerou o log (build/main.elf)")
+    ap.add_argument("input", nargs="?", help="captura ou porta serial (padrão: entrada padrão)")
+    args = ap.parse_args()
+
+    elf = Elf(args.elf)
+    stream = open(args.input, "rb", buffering=0) if args.input else sys.stdin.buffer
+    try:
+        Decoder(elf, sys.stdout).feed(stream)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,348 @@
+#!/usr/bin/env python3
+"""
+Modelo no computador do barramento 1-Wire (onewire.pio + onewire.c).
+
+Interpreta o programa do PIO ciclo a ciclo (1 ciclo = 1 µs) sobre um
+barramento em dreno aberto com sondas DS18B20 simuladas, confere os tempos
+de cada slot contra a folha de dados e executa a busca de ROM e a leitura
+das temperaturas com os mesmos passos de onewire.c e acq_ds18b20.c.
+
+Uso:
+    tools/onewire_model.py [onewire.pio] [--probes 3] [--seed 1]
+
+Termina com erro se algum tempo sair da especificação ou se as ROMs e as
+temperaturas lidas não forem as das sondas simuladas.
+"""
+
+import argparse
+import os
+import random
+import re
+import sys
+
+SLOT_RESET = 2
+SLOT_READ = 1
+
+
+def crc8(data):
+    crc = 0
+    for b in data:
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8C if (crc ^ b) & 1 else crc >> 1
+            b >>= 1
+    return crc
+
+
+# --- Programa do PIO -------------------------------------------------------
+
+def parse_program(path):
+    prog, labels = [], {}
+    wrap_target, wrap = 0, None
+    active = False
+    for raw in open(path, encoding="utf-8"):
+        line = raw.split(";")[0].strip()
+        if line.startswith("%"):
+            active = False
+        if line.startswith(".program"):
+            active = True
+            continue
+        if not active or not line:
+            continue
+        if line == ".wrap_target":
+            wrap_target = len(prog)
+            continue
+        if line == ".wrap":
+            wrap = len(prog) - 1
+            continue
+        if line.startswith("."):
+            continue
+        m = re.match(r"(\w+):$", line)
+        if m:
+            labels[m.group(1)] = len(prog)
+            continue
+        delay = 0
+        m = re.search(r"\[(\d+)\]", line)
+        if m:
+            delay = int(m.group(1))
+            line = line[:m.start()].strip()
+        side = None
+        m = re.search(r"\bside\s+(\d+)", line)
+        if m:
+            side = int(m.group(1))
+            line = line[:m.start()].strip()
+        op, _, args = line.partition(" ")
+        prog.append((op, [a.strip() for a in args.split(",")] if args else [], side, delay))
+    return prog, labels, wrap_target, wrap if wrap is not None else len(prog) - 1
+
+
+class Pio:
+    """Máquina de estados com autopull de 2 bits e autopush de 1 bit."""
+
+    def __init__(self, program):
+        self.prog, self.labels, self.wrap_target, self.wrap = program
+        self.pc = 0
+        self.x = self.y = 0
+        self.osr, self.osr_count = 0, 2     # OSR vazio
+        self.txf, self.rxf = [], []
+        self.pindir = 0
+        self.delay = 0
+
+    def step(self, bus_level):
+        """Executa um ciclo; retorna False se parado esperando a FIFO."""
+        if self.delay:
+            self.delay -= 1
+            return True
+        op, args, side, delay = self.prog[self.pc]
+        if side is not None:
+            self.pindir = side
+        nxt = self.wrap_target if self.pc == self.wrap else self.pc + 1
+
+        if op == "out":
+            if self.osr_count >= 2:
+                if not self.txf:
+                    return False
+                self.osr, self.osr_count = self.txf.pop(0), 0
+            bit = self.osr & 1
+            self.osr >>= 1
+            self.osr_count += 1
+            setattr(self, args[0], bit)
+        elif op == "in":
+            self.rxf.append(bus_level << 31)
+        elif op == "set":
+            setattr(self, args[0], int(args[1]))
+        elif op == "jmp":
+            cond, target = (args[0].split() + [None])[:2] if " " in args[0] else (None, args[0])
+            take = True
+            if cond == "!x":
+                take = self.x == 0
+            elif cond == "!y":
+                take = self.y == 0
+            elif cond == "x--":
+                take = self.x != 0
+                self.x = (self.x - 1) & 0xFFFFFFFF
+            if take:
+                nxt = self.labels[target]
+        elif op != "nop":
+            raise ValueError(op)
+        self.pc = nxt
+        self.delay = delay
+        return True
+
+
+# --- Sondas ----------------------------------------------------------------
+
+class Probe:
+    def __init__(self, rom, temp):
+        self.rom, self.temp = rom, temp
+        self.raw = int(round(temp * 16)) & 0xFFFF
+        self.scratch = [0x50, 0x05, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10]  # 85 °C no boot
+        self.low_time = 0
+        self.since_edge = None
+        self.pull_until = -1
+        self.presence_at = None
+        self.proto = None
+        self.action = None
+
+    def reset(self, now):
+        self.presence_at = now + 30
+        self.proto = self.protocol()
+        self.action = next(self.proto)
+
+    def recv_byte(self):
+        v = 0
+        for i in range(8):
+            v |= (yield ("read",)) << i
+        return v
+
+    def send_bits(self, bits):
+        for b in bits:
+            yield ("write", b)
+
+    def protocol(self):
+        rom_bits = [(self.rom >> i) & 1 for i in range(64)]
+        cmd = yield from self.recv_byte()
+        if cmd == 0xF0:
+            for b in rom_bits:
+                yield ("write", b)
+                yield ("write", b ^ 1)
+                if (yield ("read",)) != b:
+                    break
+            while True:
+                yield ("idle",)
+        if cmd == 0x55:
+            for b in rom_bits:
+                if (yield ("read",)) != b:
+                    while True:
+                        yield ("idle",)
+        elif cmd != 0xCC:
+            while True:
+                yield ("idle",)
+        fn = yield from self.recv_byte()
+        if fn == 0x44:
+            self.scratch[0], self.scratch[1] = self.raw & 0xFF, self.raw >> 8
+        elif fn == 0xBE:
+            data = self.scratch + [crc8(self.scratch)]
+            for byte in data:
+                yield from self.send_bits((byte >> i) & 1 for i in range(8))
+        while True:
+            yield ("idle",)
+
+    def pulls_low(self, now):
+        if self.presence_at is not None and self.presence_at <= now < self.presence_at + 120:
+            return True
+        return now < self.pull_until
+
+    def observe(self, now, level, falling, rising):
+        if level == 0:
+            self.low_time += 1
+        if rising and self.low_time >= 480:
+            self.reset(now)
+        if rising:
+            self.low_time = 0
+        if falling and self.proto and not (self.presence_at and now < self.presence_at + 120):
+            kind = self.action[0]
+            self.since_edge = 0
+            if kind == "write" and self.action[1] == 0:
+                self.pull_until = now + 30
+        elif self.since_edge is not None:
+            self.since_edge += 1
+            if self.since_edge == 30:
+                self.since_edge = None
+                kind = self.action[0]
+                self.action = self.proto.send(level if kind == "read" else None)
+
+
+# --- Barramento ------------------------------------------------------------
+
+class Bus:
+    def __init__(self, pio, probes):
+        self.pio, self.probes = pio, probes
+        self.now = 0
+        self.level = 1
+        self.low_start = None
+        self.errors = []
+
+    def level_now(self):
+        if self.pio.pindir:
+            return 0
+        return 0 if any(p.pulls_low(self.now) for p in self.probes) else 1
+
+    def run(self, words):
+        """Envia slots e devolve as palavras lidas."""
+        self.pio.txf.extend(words)
+        start = len(self.pio.rxf)
+        idle = 0
+        while len(self.pio.rxf) - start < len(words) or idle < 70:
+            running = self.pio.step(self.level)
+            idle = 0 if running or self.pio.txf else idle + 1
+            new = self.level_now()
+            falling, rising = self.level == 1 and new == 0, self.level == 0 and new == 1
+            self.check_timing()
+            for p in self.probes:
+                p.observe(self.now, new, falling, rising)
+            self.level = new
+            self.now += 1
+        out = self.pio.rxf[start:]
+        del self.pio.rxf[start:]
+        return out
+
+    def check_timing(self):
+        # Tempos em que o mestre segura o barramento em nível baixo
+        if self.pio.pindir and self.low_start is None:
+            self.low_start = self.now
+        elif not self.pio.pindir and self.low_start is not None:
+            low = self.now - self.low_start
+            if not (1 <= low <= 15 or 60 <= low <= 120 or low >= 480):
+                self.errors.append(f"{self.now} us: pulso baixo de {low} us fora da especificação")
+            self.low_start = None
+
+
+# --- Mestre (mesmos passos de onewire.c / acq_ds18b20.c) -------------------
+
+def byte_slots(v):
+    return [(v >> i) & 1 for i in range(8)]
+
+
+def get_byte(rx, first):
+    return sum(((rx[first + i] >> 31) & 1) << i for i in range(8))
+
+
+def search(bus, max_roms):
+    roms, last_disc, rom = [], 0, 0
+    while True:
+        if bus.run([SLOT_RESET])[0] >> 31:
+            break
+        bus.run(byte_slots(0xF0))
+        last_zero = 0
+        for n in range(1, 65):
+            bit, cmp = (w >> 31 for w in bus.run([SLOT_READ, SLOT_READ]))
+            if bit and cmp:
+                return roms
+            if bit != cmp:
+                d = bit
+            else:
+                d = (rom >> (n - 1)) & 1 if n < last_disc else int(n == last_disc)
+                if not d:
+                    last_zero = n
+            rom = rom | (1 << (n - 1)) if d else rom & ~(1 << (n - 1))
+            bus.run([d])
+        last_disc = last_zero
+        if crc8([(rom >> (8 * i)) & 0xFF for i in range(8)]) == 0:
+            roms.append(rom)
+        if not last_disc or len(roms) >= max_roms:
+            break
+    return roms
+
+
+def read_temps(bus, roms):
+    bus.run([SLOT_RESET] + byte_slots(0xCC) + byte_slots(0x44))
+    temps = {}
+    for rom in roms:
+        words = [SLOT_RESET] + byte_slots(0x55)
+        for i in range(8):
+            words += byte_slots((rom >> (8 * i)) & 0xFF)
+        words += byte_slots(0xBE)
+        first = len(words)
+        words += [SLOT_READ] * 72
+        rx = bus.run(words)
+        scratch = [get_byte(rx, first + 8 * b) for b in range(9)]
+        if rx[0] >> 31 == 0 and crc8(scratch) == 0:
+            raw = scratch[0] | scratch[1] << 8
+            temps[rom] = (raw - 0x10000 if raw & 0x8000 else raw) / 16.0
+    return temps
+
+
+def make_rom(rng):
+    body = [0x28] + [rng.randrange(256) for _ in range(6)]
+    body.append(crc8(body))
+    return sum(b << (8 * i) for i, b in enumerate(body))
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("pio", nargs="?", default=os.path.join(here, "..", "onewire.pio"))
+    ap.add_argument("--probes", type=int, default=3)
+    ap.add_argument("--seed", type=int, default=1)
+    args = ap.parse_args()
+
+    rng = random.Random(args.seed)
+    probes = [Probe(make_rom(rng), round(rng.uniform(-10, 75) * 16) / 16) for _ in range(args.probes)]
+    bus = Bus(Pio(parse_program(args.pio)), probes)
+
+    roms = search(bus, 4)
+    temps = read_temps(bus, roms)
+
+    ok = sorted(roms) == sorted(p.rom for p in probes[:4]) and not bus.errors
+    for p in probes:
+        got = temps.get(p.rom)
+        print(f"ROM {p.rom:016X}  simulada {p.temp:7.4f}  lida {got if got is None else f'{got:7.4f}'}")
+        ok &= got == p.temp
+    for e in bus.errors[:10]:
+        print(e, file=sys.stderr)
+    print(f"{len(roms)} ROM(s) encontradas, {bus.now / 1000:.1f} ms de barramento")
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,390 @@
+#!/usr/bin/env python3
+"""
+Atualização do firmware pela USB (lado do computador de ota.c).
+
+Subcomandos:
+    tools/ota.py delta ANTIGO NOVO [-o patch.bin]
+        Gera o patch de NOVO contra ANTIGO (ELF ou .bin) e mostra o tamanho.
+    tools/ota.py send ANTIGO.elf NOVO.elf /dev/ttyACM0
+        Envia o patch para o aparelho que roda ANTIGO.elf, confere a imagem
+        montada e manda aplicar. O ELF antigo também decodifica as respostas
+        que chegam pelo log binário (tools/log_decode.py).
+    tools/ota.py sim [ANTIGO NOVO] [--seed 1]
+        Executa a atualização inteira contra ota.c, link.c e crc.c
+        compilados no computador (tools/host/ota_sim.c) sobre a flash do
+        host (apagamento por setor, gravação por página só zerando bits),
+        com quadros perdidos e corrompidos no enlace, patch contra a base
+        errada e queda de energia em cada passo da instalação. Sem
+        arquivos, usa imagens sintéticas.
+
+Patch: sequência de operações sobre a imagem em execução
+    'C' <u32 origem> <u32 tamanho>   copia bytes da imagem atual
+    'L' <u16 tamanho> <bytes>        bytes literais
+Quadros (COBS, CRC-16 CCITT-FALSE no fim, terminados em 0x00):
+    'B' <u32 tamanho novo> <u32 CRC-32 novo> <u32 tamanho base> <u32 CRC-32 base>
+    'D' <u16 sequência> <até 256 bytes do patch>
+    'E'    'A'
+"""
+
+import argparse
+import binascii
+import os
+import random
+import select
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from host_build import ROOT, build  # noqa: E402
+from log_decode import Elf, cobs_decode, format_record  # noqa: E402
+
+FLASH_SIZE = 2 * 1024 * 1024
+SECTOR = 4096
+CHUNK = 256
+BLOCK = 16                  # Trecho mínimo procurado na imagem antiga
+XIP_BASE = 0x10000000
+SIM_SOURCES = ["tools/host/ota_sim.c", "tools/host/host.c", "ota.c", "link.c", "crc.c", "control.c"]
+
+
+# --- Imagens e patch --------------------------------------------------------
+
+def load_image(path):
+    """Imagem da flash a partir de um .bin ou dos segmentos do ELF."""
+    data = open(path, "rb").read()
+    if data[:4] != b"\x7fELF":
+        return data
+    phoff, = struct.unpack_from("<I", data, 0x1C)
+    phentsize, phnum = struct.unpack_from("<HH", data, 0x2A)
+    image = bytearray()
+    for i in range(phnum):
+        typ, off, _, paddr, filesz = struct.unpack_from("<IIIII", data, phoff + i * phentsize)
+        if typ != 1 or filesz == 0 or not XIP_BASE <= paddr < XIP_BASE + FLASH_SIZE:
+            continue
+        at = paddr - XIP_BASE
+        if len(image) < at + filesz:
+            image.extend(bytes(at + filesz - len(image)))   # Lacunas em 0, como o objcopy
+        image[at:at + filesz] = data[off:off + filesz]
+    return bytes(image)
+
+
+def make_delta(old, new):
+    """Patch guloso: trechos de BLOCK bytes da imagem antiga indexados por
+    conteúdo, cada posição da nova estendida pelo candidato mais longo."""
+    index = {}
+    for i in range(len(old) - BLOCK + 1):
+        lst = index.setdefault(old[i:i + BLOCK], [])
+        if len(lst) < 8:
+            lst.append(i)
+    out, lit, i = bytearray(), bytearray(), 0
+
+    def flush_literal():
+        for k in range(0, len(lit), 0xFFFF):
+            part = lit[k:k + 0xFFFF]
+            out.extend(b"L" + struct.pack("<H", len(part)) + part)
+        lit.clear()
+
+    while i < len(new):
+        best, best_src = 0, 0
+        for src in index.get(new[i:i + BLOCK], ()):
+            n = BLOCK
+            while i + n < len(new) and src + n < len(old) and new[i + n] == old[src + n]:
+                n += 1
+            if n > best:
+                best, best_src = n, src
+        if best:
+            flush_literal()
+            out.extend(b"C" + struct.pack("<II", best_src, best))
+            i += best
+        else:
+            lit.append(new[i])
+            i += 1
+    flush_literal()
+    return bytes(out)
+
+
+def cobs_encode(data):
+    out, block = bytearray(), bytearray()
+    for b in data:
+        if b == 0:
+            out += bytes([len(block) + 1]) + block
+            block.clear()
+        else:
+            block.append(b)
+            if len(block) == 254:
+                out += b"\xff" + block
+                block.clear()
+    out += bytes([len(block) + 1]) + block
+    return bytes(out)
+
+
+def frame(payload):
+    return cobs_encode(payload + struct.pack("<H", binascii.crc_hqx(payload, 0xFFFF))) + b"\0"
+
+
+def frames_for(old, new, patch):
+    """Quadros da atualização, na ordem de envio, com o tipo esperado."""
+    out = [("B", frame(b"B" + struct.pack("<IIII", len(new), zlib.crc32(new), len(old), zlib.crc32(old))))]
+    for seq, k in enumerate(range(0, len(patch), CHUNK)):
+        out.append(("D", frame(b"D" + struct.pack("<H", seq & 0xFFFF) + patch[k:k + CHUNK])))
+    out.append(("E", frame(b"E")))
+    out.append(("A", frame(b"A")))
+    return out
+
+
+# --- Envio pela serial ------------------------------------------------------
+
+class Port:
+    def __init__(self, path, elf):
+        import termios
+        import tty
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.elf, self.buf = elf, bytearray()
+
+    def send(self, data):
+        os.write(self.fd, data)
+
+    def replies(self, timeout, prefix="OTA "):
+        """Linhas do log recebidas até o timeout; as que começam com prefix
+        são devolvidas (sem o prefixo, separadas por espaço)."""
+        end = time.time() + timeout
+        while time.time() < end:
+            if not select.select([self.fd], [], [], max(end - time.time(), 0))[0]:
+                break
+            self.buf += os.read(self.fd, 4096)
+            while b"\0" in self.buf:
+                raw, _, rest = bytes(self.buf).partition(b"\0")
+                self.buf = bytearray(rest)
+                data = cobs_decode(raw)
+                if not data or len(data) < 10 or len(data) % 4 != 2:
+                    continue
+                if binascii.crc_hqx(data[:-2], 0xFFFF) != int.from_bytes(data[-2:], "little"):
+                    continue
+                words = struct.unpack(f"<{len(data) // 4}I", data[:-2])
+                text = format_record(self.elf, words)
+                if text and text.startswith(prefix):
+                    yield text.split()[1:]
+                elif text:
+                    print("  |", text)
+
+
+def send(args):
+    elf = Elf(args.old)
+    old, new = load_image(args.old), load_image(args.new)
+    patch = make_delta(old, new)
+    print(f"imagem {len(new)} bytes, patch {len(patch)} bytes ({100 * len(patch) / len(new):.1f}%)")
+    port = Port(args.port, elf)
+    timeouts = {"B": 5.0, "D": 1.0, "E": 5.0, "A": 2.0}
+    t0 = time.time()
+    for n, (typ, data) in enumerate(frames_for(old, new, patch)):
+        for attempt in range(6):
+            port.send(data)
+            reply = next((r for r in port.replies(timeouts[typ]) if r[0] == typ), None)
+            if reply is None:
+                continue                    # Quadro ou confirmação perdidos: repete
+            if reply[1] != "ok":
+                sys.exit(f"aparelho recusou '{typ}': {reply[1]}")
+            break
+        else:
+            sys.exit(f"sem resposta ao quadro '{typ}'")
+        if typ == "D":
+            print(f"\r{n}/{len(patch) // CHUNK + 1} quadros", end="", flush=True)
+    print(f"\nimagem conferida e aplicada em {time.time() - t0:.1f} s; o aparelho reinicia")
+
+
+# --- Simulação --------------------------------------------------------------
+
+class Device:
+    """ota.c, link.c e crc.c compilados no computador (tools/host/ota_sim.c)
+    sobre a flash do host: apagamento por setor, gravação por página só
+    zerando bits e queda de energia numa operação escolhida."""
+
+    def __init__(self, exe, image, workdir):
+        self.proc = subprocess.Popen([exe], stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True)
+        self.path = os.path.join(workdir, "flash.bin")
+        self.replies, self.off = [], None
+        open(self.path, "wb").write(image)
+        self.command(f"load {self.path}")
+
+    def command(self, line):
+        self.proc.stdin.write(line + "\n")
+        self.proc.stdin.flush()
+        for reply in iter(self.proc.stdout.readline, ".\n"):
+            if not reply:
+                sys.exit(f"ota_sim terminou no comando {line.split()[0]}")
+            typ, status, value = reply.split()
+            if typ == "X":
+                self.off, self.ops = status, int(value)
+            else:
+                self.replies.append((typ, status, int(value)))
+
+    def receive(self, wire):
+        """Bytes pela USB, processados até o aparelho ficar ocioso."""
+        self.command("frame " + wire.hex())
+
+    def cut(self, op):
+        self.command(f"cut {op}")
+
+    def flash(self):
+        self.command(f"save {self.path}")
+        return open(self.path, "rb").read()
+
+    def close(self):
+        self.proc.stdin.close()
+        self.proc.wait()
+
+
+def boot_state(mem, old, new):
+    if mem[:len(new)] == new:
+        return "nova"
+    if mem[:SECTOR] == b"\xff" * SECTOR:
+        return "bootsel"        # Sem boot2 válido: o bootrom entra no modo USB
+    if mem[:len(old)] == old:
+        return "antiga"
+    return "corrompida"
+
+
+def run_link(dev, frames, rng, loss):
+    """Computador e aparelho sobre um enlace que perde e corrompe quadros."""
+    sent = 0
+    for typ, data in frames:
+        for _ in range(20):
+            sent += 1
+            wire = bytearray(data)
+            if rng.random() < loss:
+                continue                            # Quadro perdido
+            if rng.random() < loss:
+                wire[rng.randrange(len(wire) - 1)] ^= 1 << rng.randrange(8)
+            dev.receive(bytes(wire))
+            if dev.off:
+                # O 'A' reinicia o aparelho na imagem nova: a USB cai e o
+                # computador não espera mais a confirmação
+                return ("ok" if typ == "A" and dev.off == "reset" else dev.off), sent
+            got = [r for r in dev.replies if r[0] == typ]
+            dev.replies.clear()
+            if got and rng.random() >= loss:        # Confirmação pode se perder
+                if got[-1][1] != "ok":
+                    return got[-1][1], sent
+                break
+        else:
+            return "sem-resposta", sent
+    return "ok", sent
+
+
+def synthetic_images(rng):
+    """Imagem 'firmware' com código repetitivo e a mesma com edições."""
+    words = [rng.getrandbits(32) for _ in range(512)]
+    old = b"".join(struct.pack("<I", rng.choice(words)) for _ in range(30000))
+    new = bytearray(old)
+    for _ in range(20):                             # Trechos inseridos e removidos
+        at = rng.randrange(len(new))
+        if rng.random() < 0.5:
+            new[at:at] = bytes(rng.getrandbits(8) for _ in range(rng.randrange(4, 200)))
+        else:
+            del new[at:at + rng.randrange(4, 200)]
+    for _ in range(200):                            # Constantes alteradas
+        at = rng.randrange(len(new) - 4) & ~3
+        new[at:at + 4] = struct.pack("<I", rng.getrandbits(32))
+    return old, bytes(new)
+
+
+def sim(args):
+    rng = random.Random(args.seed)
+    if args.old and args.new:
+        old, new = load_image(args.old), load_image(args.new)
+    else:
+        old, new = synthetic_images(rng)
+    patch = make_delta(old, new)
+    frames = frames_for(old, new, patch)
+    print(f"imagem {len(new)} bytes, patch {len(patch)} bytes ({100 * len(patch) / len(new):.1f}%), "
+          f"{len(frames)} quadros")
+    exe = build("ota_sim", SIM_SOURCES, args.build_dir)
+    work = tempfile.mkdtemp(prefix="ota_sim")
+    errors = 0
+
+    # 1. Atualização com perdas no enlace; o último quadro ('A') instala e
+    # reinicia o aparelho
+    for loss in (0.0, 0.05, 0.2):
+        dev = Device(exe, old, work)
+        status, sent = run_link(dev, frames, rng, loss)
+        state = boot_state(dev.flash(), old, new)
+        dev.close()
+        ok = status == "ok" and state == "nova" and dev.off == "reset"
+        errors += not ok
+        print(f"perda {loss:4.0%}: {status}, {sent} envios, flash {state}, "
+              f"{dev.ops} operações na flash")
+
+    # 2. Patch feito contra outra imagem
+    other = bytearray(old)
+    other[100] ^= 0xFF
+    dev = Device(exe, bytes(other), work)
+    status, _ = run_link(dev, frames, rng, 0.0)
+    errors += status != "erro-base"
+    print(f"base errada: {status}, flash {boot_state(dev.flash(), bytes(other), new)}")
+    dev.close()
+
+    # 3. Queda de energia em cada operação da instalação: um aparelho novo
+    # por corte, com a imagem conferida na área de preparo. A primeira
+    # passada, sem corte, conta as operações do ota_install
+    def install(cut):
+        dev = Device(exe, old, work)
+        for typ, data in frames[:-1]:
+            dev.receive(data)
+        dev.cut(cut)
+        dev.receive(frames[-1][1])
+        state = boot_state(dev.flash(), old, new)
+        dev.close()
+        return state, dev.ops
+
+    _, n_ops = install(-1)
+    states = {}
+    for cut in range(n_ops + 1):
+        state, _ = install(cut)
+        states[state] = states.get(state, 0) + 1
+    errors += "corrompida" in states
+    print(f"queda na instalação ({n_ops} operações):", ", ".join(f"{k} {v}" for k, v in sorted(states.items())))
+    shutil.rmtree(work)
+
+    if errors:
+        sys.exit(f"{errors} falha(s)")
+    print("ok")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    p = sub.add_parser("delta")
+    p.add_argument("old")
+    p.add_argument("new")
+    p.add_argument("-o", "--output")
+    p = sub.add_parser("send")
+    p.add_argument("old")
+    p.add_argument("new")
+    p.add_argument("port")
+    p = sub.add_parser("sim")
+    p.add_argument("old", nargs="?")
+    p.add_argument("new", nargs="?")
+    p.add_argument("--seed", type=int, default=1)
+    p.add_argument("--build-dir", default=os.path.join(ROOT, "build", "ota_sim"))
+    args = ap.parse_args()
+
+    if args.cmd == "delta":
+        old, new = load_image(args.old), load_image(args.new)
+        patch = make_delta(old, new)
+        print(f"imagem {len(new)} bytes, patch {len(patch)} bytes ({100 * len(patch) / len(new):.1f}%)")
+        if args.output:
+            open(args.output, "wb").write(patch)
+    elif args.cmd == "send":
+        send(args)
+    else:
+        sim(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""
+Malha fechada no computador: leira simulada contra o firmware.
+
+Compila, com gcc e os substitutos do SDK de tools/host/, os módulos do
+firmware que ficam entre o conversor e as saídas (acq_sim.c e plant.c,
+sensor.c, filter.c, rate.c, lerp.c e control.c) junto com
+tools/host/plant_sim.c, que repete a sequência do callback de amostragem
+de main.c em tempo virtual: um mês de operação (5 milhões de amostras e 26 milhões de
+execuções do laço de controle) roda em cerca de um segundo.
+
+Uso:
+    tools/plant_sim.py [chave=valor ...] [--trace traco.txt] [-j N]
+        chave=valor vai para o simulador (ex.: days=60 mode=2 kp=200 ki=0.5
+        ambient=15 heat_max=4); ver options[] em tools/host/plant_sim.c.
+        mode: 0 desligado, 1 liga/desliga, 2 PID. adaptive=1 usa o filtro
+        adaptativo no lugar da média móvel.
+    Listas separadas por vírgula varrem o produto cartesiano dos valores em
+    paralelo, um processo por núcleo:
+        tools/plant_sim.py days=60 mode=2 kp=100,200,400 ki=0.2,0.5,1 seed=1,2,3
+
+Cada execução termina com uma linha de resumo:
+    max         maior temperatura do núcleo (°C)
+    h55 / h70   horas com o núcleo acima de 55 °C (higienização) e de 70 °C
+    chegada55   horas até o núcleo chegar a 55 °C
+    erro_rms    erro da temperatura filtrada em relação ao núcleo (°C)
+    excesso_rms quanto o núcleo passou do alvo (acima, resfriando), depois
+                de atingi-lo (°C)
+    soprador    ciclo de trabalho médio do soprador
+    partidas    vezes em que o soprador saiu de zero
+    led         trocas do LED de temperatura baixa (oscilação do alarme)
+"""
+
+import argparse
+import itertools
+import multiprocessing
+import os
+import subprocess
+
+from host_build import ROOT, build
+
+SOURCES = ["tools/host/plant_sim.c", "tools/host/host.c", "plant.c", "acq_sim.c", "sensor.c",
+           "filter.c", "rate.c", "control.c", "lerp.c"]
+
+
+def run(job):
+    exe, args, trace = job
+    out = subprocess.run([exe, *args], check=True, capture_output=True, text=True).stdout
+    lines = out.splitlines()
+    if trace:
+        with open(trace, "w") as f:
+            f.write("\n".join(lines[:-1]) + "\n")
+    summary = dict(kv.split("=", 1) for kv in lines[-1].split())
+    return args, summary
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0],
+                                 formatter_class=argparse.RawDescriptionHelpFormatter,
+                                 epilog=__doc__.split("\n\n", 2)[2])
+    ap.add_argument("params", nargs="*", metavar="chave=valor")
+    ap.add_argument("--trace", help="arquivo do traço (uma linha a cada --trace-min minutos)")
+    ap.add_argument("--trace-min", type=float, default=10.0)
+    ap.add_argument("-j", "--jobs", type=int, default=os.cpu_count())
+    ap.add_argument("--build-dir", default=os.path.join(ROOT, "build", "plant_sim"))
+    args = ap.parse_args()
+
+    keys, values = [], []
+    for p in args.params:
+        if "=" not in p:
+            ap.error(f"esperado chave=valor: {p}")
+        k, v = p.split("=", 1)
+        keys.append(k)
+        values.append(v.split(","))
+    combos = [[f"{k}={v}" for k, v in zip(keys, c)] for c in itertools.product(*values)]
+    if args.trace and len(combos) > 1:
+        ap.error("--trace só com uma execução")
+
+    exe = build("plant_sim", SOURCES, args.build_dir)
+    extra = [f"trace={args.trace_min}"] if args.trace else []
+    jobs = [(exe, c + extra, args.trace) for c in combos]
+    with multiprocessing.Pool(min(args.jobs, len(jobs))) as pool:
+        for params, summary in pool.imap(run, jobs):
+            swept = [p for p, v in zip(params, values) if len(v) > 1] if len(combos) > 1 else params
+            print(" ".join(swept), "|", " ".join(f"{k}={v}" for k, v in summary.items()))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Comprime um bitmap organizado em páginas (formato do SSD1306) no RLE
+decodificado por blit.c e imprime o array C resultante.
+
+Uso:
+    tools/rle_encode.py raspberry26x32.h [nome_do_array]
+
+Formato:
+    byte de controle c < 0x80  -> seguem c+1 bytes literais
+    byte de controle c >= 0x80 -> o próximo byte se repete (c & 0x7F)+1 vezes
+"""
+
+import re
+import sys
+
+MAX_RUN = 128
+
+
+def rle_encode(data):
+    out = []
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_RUN]
+            del literal[:MAX_RUN]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < MAX_RUN:
+            run += 1
+        # Repetições de 2 bytes não compensam no meio de um literal
+        if run >= 3 or (run == 2 and not literal):
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush_literal()
+    return out
+
+
+def rle_decode(data):
+    out = []
+    i = 0
+    while i < len(data):
+        c = data[i]
+        i += 1
+        n = (c & 0x7F) + 1
+        if c & 0x80:
+            out.extend([data[i]] * n)
+            i += 1
+        else:
+            out.extend(data[i:i + n])
+            i += n
+    return out
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    text = open(sys.argv[1], encoding="utf-8").read()
+    body = text[text.index("{") + 1:text.rindex("}")]
+    data = [int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", body)]
+    name = sys.argv[2] if len(sys.argv) > 2 else "bitmap_rle"
+
+    enc = rle_encode(data)
+    assert rle_decode(enc) == data
+
+    print(f"// {len(data)} bytes -> {len(enc)} bytes (RLE)")
+    print(f"static const uint8_t {name}[] = {{")
+    for i in range(0, len(enc), 16):
+        print("    " + ", ".join(f"0x{b:02x}" for b in enc[i:i + 16]) + ",")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""
+Modelo no computador do conversor sigma-delta (sdm_adc.pio + acq_sdm.c).
+
+Simula ciclo a ciclo o programa do PIO (3 ciclos por bit e o tempo morto
+no fim de cada janela), o nó RC com as duas resistências e o comparador,
+e decodifica as contagens com a mesma fórmula de acq_sdm.c. Serve para
+escolher os componentes e conferir o erro antes de montar o circuito.
+
+Uso:
+    tools/sdm_model.py [--vin 0.45:0.75:0.05] [--windows 2] [--window 65536]
+                       [--rin 100e3] [--rfb 100e3] [--cap 100e-9]
+                       [--noise 0.0] [--check 0.5]
+
+--check N termina com erro se algum ponto errar mais que N mV.
+"""
+
+import argparse
+import random
+import sys
+
+VREF = 3.3
+BIT_HZ = 1_000_000
+CYCLES_PER_BIT = 3
+DIODE_MV_PER_C = 2.1
+
+
+def simulate(vin, args, rng):
+    """Retorna as contagens de bits em 1 de cada janela."""
+    dt = 1.0 / (BIT_HZ * CYCLES_PER_BIT)
+    vth = VREF / 2
+    v = vth          # Tensão no capacitor
+    fb = 0           # Pino de realimentação
+
+    def step(cycles):
+        nonlocal v
+        for _ in range(cycles):
+            i = (vin - v) / args.rin + (fb * VREF - v) / args.rfb
+            v += i * dt / args.cap
+
+    counts = []
+    for _ in range(args.windows):
+        step(2)                                      # mov x / mov y
+        count = 0
+        for _ in range(args.window):
+            noise = rng.gauss(0.0, args.noise) if args.noise else 0.0
+            above = v + noise > vth                  # jmp pin
+            step(1)
+            fb = 0 if above else 1                   # side-set
+            count += not above
+            step(2)                                  # side-set + jmp y--
+        step(2 + (fb == 1))                          # jmp done / mov isr / push
+        counts.append(count)
+    return counts
+
+
+def decode(count, args):
+    vth = VREF / 2
+    d = count / args.window
+    return vth - (args.rin / args.rfb) * (d * VREF - vth)
+
+
+def parse_range(text):
+    lo, hi, step = (float(x) for x in text.split(":"))
+    n = int(round((hi - lo) / step))
+    return [lo + i * step for i in range(n + 1)]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("--vin", default="0.45:0.75:0.05")
+    ap.add_argument("--windows", type=int, default=2)
+    ap.add_argument("--window", type=int, default=65536)
+    ap.add_argument("--rin", type=float, default=100e3)
+    ap.add_argument("--rfb", type=float, default=100e3)
+    ap.add_argument("--cap", type=float, default=100e-9)
+    ap.add_argument("--noise", type=float, default=0.0, help="ruído do comparador (V rms)")
+    ap.add_argument("--check", type=float, default=None, help="erro máximo (mV)")
+    args = ap.parse_args()
+
+    rng = random.Random(1)
+    worst = 0.0
+    print(" vin(V)   media(V)   erro(mV)  erro(C)  pp(mV)")
+    for vin in parse_range(args.vin):
+        counts = simulate(vin, args, rng)
+        values = [decode(c, args) for c in counts]
+        mean = sum(values) / len(values)
+        err = (mean - vin) * 1000
+        pp = (max(values) - min(values)) * 1000
+        worst = max(worst, abs(err))
+        print(f"{vin:7.4f}  {mean:9.6f}  {err:8.3f}  {err / DIODE_MV_PER_C:7.3f}  {pp:6.3f}")
+
+    lsb = VREF / args.window * 1000
+    print(f"LSB por janela: {lsb:.4f} mV ({lsb / DIODE_MV_PER_C:.4f} C)")
+    if args.check is not None and worst > args.check:
+        print(f"erro máximo {worst:.3f} mV acima de {args.check} mV", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())